@@ -0,0 +1,200 @@
+/*****************************************************************//**
+ * \file   alloc_tracker.cpp
+ * \brief  implementation file for the allocation tracker, and the replaced
+ * global operator new and delete. Nothing here may allocate through new,
+ * zones are kept in a fixed table and counters are atomic
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "alloc_tracker.h"
+
+#ifdef GUNFIGHT_PROFILE
+#include "raylib.h"
+#include "config.h"
+#include "profiler.h"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace {
+	const char* UNTRACKED = "untracked";
+
+	struct zone_slot {
+		std::atomic<const char*> name = nullptr;
+		std::atomic<std::size_t> count = 0;
+		std::atomic<std::size_t> bytes = 0;
+		std::atomic<std::size_t> total_count = 0;
+		std::atomic<std::size_t> total_bytes = 0;
+		std::size_t last_count = 0; // copied at the end of each frame
+		std::size_t last_bytes = 0;
+	};
+
+	struct tracker_state {
+		std::array<zone_slot, config::ALLOC_MAX_ZONES> slots;
+		std::atomic<std::size_t> used = 0;
+		std::mutex registering; // only taken the first time a zone allocates
+		std::atomic<std::size_t> frame_count = 0;
+		std::atomic<std::size_t> frame_bytes = 0;
+		std::atomic<std::size_t> frame_frees = 0;
+		alloc::frame_allocations last_frame;
+		std::size_t budget = config::FRAME_ALLOCATION_BUDGET;
+		bool strict = config::STRICT_ALLOCATION_BUDGET;
+	};
+
+	/**  constructed on first use, which may be from inside operator new */
+	tracker_state& state() {
+		static tracker_state s;
+		return s;
+	}
+
+	/**  room for the size in front of each block, keeping the default alignment */
+	constexpr std::size_t HEADER = alignof(std::max_align_t);
+
+	zone_slot& find_slot(const char* name) {
+		auto& s = state();
+		auto used = s.used.load(std::memory_order_acquire);
+		for (std::size_t i = 0; i < used; ++i) {
+			auto slot_name = s.slots[i].name.load(std::memory_order_relaxed);
+			if (slot_name == name or std::strcmp(slot_name, name) == 0) {
+				return s.slots[i];
+			}
+		}
+		std::lock_guard lock(s.registering);
+		used = s.used.load(std::memory_order_relaxed);
+		for (std::size_t i = 0; i < used; ++i) {
+			if (std::strcmp(s.slots[i].name.load(std::memory_order_relaxed), name) == 0) {
+				return s.slots[i];
+			}
+		}
+		/**  when the table is full the last slot collects everything else */
+		if (used == s.slots.size()) {
+			return s.slots.back();
+		}
+		s.slots[used].name.store(name, std::memory_order_relaxed);
+		s.used.store(used + 1, std::memory_order_release);
+		return s.slots[used];
+	}
+
+	void record_allocation(std::size_t size) {
+		auto& s = state();
+		auto zone = profiler::current_zone();
+		auto& slot = find_slot(zone != nullptr ? zone : UNTRACKED);
+		slot.count.fetch_add(1, std::memory_order_relaxed);
+		slot.bytes.fetch_add(size, std::memory_order_relaxed);
+		slot.total_count.fetch_add(1, std::memory_order_relaxed);
+		slot.total_bytes.fetch_add(size, std::memory_order_relaxed);
+		s.frame_count.fetch_add(1, std::memory_order_relaxed);
+		s.frame_bytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	void* tracked_allocate(std::size_t size) {
+		auto block = static_cast<unsigned char*>(std::malloc(size + HEADER));
+		if (block == nullptr) {
+			return nullptr;
+		}
+		std::memcpy(block, &size, sizeof(size));
+		record_allocation(size);
+		return block + HEADER;
+	}
+
+	void tracked_free(void* p) {
+		if (p == nullptr) { return; }
+		state().frame_frees.fetch_add(1, std::memory_order_relaxed);
+		std::free(static_cast<unsigned char*>(p) - HEADER);
+	}
+}
+
+void alloc::begin_frame(){
+	auto& s = state();
+	s.frame_count = 0;
+	s.frame_bytes = 0;
+	s.frame_frees = 0;
+	for (std::size_t i = 0; i < s.used; ++i) {
+		s.slots[i].count = 0;
+		s.slots[i].bytes = 0;
+	}
+}
+
+alloc::frame_allocations alloc::end_frame(){
+	auto& s = state();
+	s.last_frame = frame_allocations{ s.frame_count, s.frame_bytes, s.frame_frees };
+	for (std::size_t i = 0; i < s.used; ++i) {
+		s.slots[i].last_count = s.slots[i].count;
+		s.slots[i].last_bytes = s.slots[i].bytes;
+	}
+	if (s.last_frame.count > s.budget) {
+		TraceLog(LOG_WARNING, "ALLOC: frame made %i allocations (%i bytes), budget is %i",
+			static_cast<int>(s.last_frame.count), static_cast<int>(s.last_frame.bytes), static_cast<int>(s.budget));
+		assert(not s.strict and "frame allocation budget exceeded");
+	}
+	return s.last_frame;
+}
+
+alloc::frame_allocations alloc::get_last_frame(){
+	return state().last_frame;
+}
+
+std::size_t alloc::zone_count(){
+	return state().used;
+}
+
+alloc::zone_allocations alloc::get_zone(std::size_t index){
+	auto& slot = state().slots[index];
+	return zone_allocations{ slot.name, slot.last_count, slot.last_bytes, slot.total_count, slot.total_bytes };
+}
+
+void alloc::set_budget(std::size_t allocations, bool strict){
+	state().budget = allocations;
+	state().strict = strict;
+}
+
+/**  replaced global allocation functions, the aligned overloads keep their defaults */
+void* operator new(std::size_t size) {
+	auto p = tracked_allocate(size);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return tracked_allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return tracked_allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+	tracked_free(p);
+}
+
+void operator delete[](void* p) noexcept {
+	tracked_free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	tracked_free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+	tracked_free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+	tracked_free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+	tracked_free(p);
+}
+#endif
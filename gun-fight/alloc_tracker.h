@@ -0,0 +1,48 @@
+/*****************************************************************//**
+ * \file   alloc_tracker.h
+ * \brief  header file for the allocation tracker. Global operator new and
+ * delete are replaced so every heap allocation is counted against the
+ * innermost open profiler zone ("untracked" outside of zones). Counts are
+ * kept per frame, and a frame allocating more than the configured budget
+ * is reported, or asserted on when the budget is strict.
+ *
+ * Built with the profiler, when GUNFIGHT_PROFILE is defined
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+
+#ifdef GUNFIGHT_PROFILE
+#include <cstddef>
+
+namespace alloc {
+	/**  allocations made under a zone */
+	struct zone_allocations {
+		const char* name;
+		std::size_t count; // in the last frame
+		std::size_t bytes;
+		std::size_t total_count; // since the program started
+		std::size_t total_bytes;
+	};
+
+	/**  allocations made during a frame */
+	struct frame_allocations {
+		std::size_t count = 0;
+		std::size_t bytes = 0;
+		std::size_t frees = 0;
+	};
+
+	/**  frames, called by the profiler */
+	void begin_frame();
+	frame_allocations end_frame(); // checks the frame against the budget
+
+	/**  the last completed frame */
+	frame_allocations get_last_frame();
+	std::size_t zone_count();
+	zone_allocations get_zone(std::size_t index);
+
+	/**  budget, allocations per frame */
+	void set_budget(std::size_t allocations, bool strict);
+}
+#endif
@@ -11,6 +11,14 @@ Texture2D animation::get_sheet(){
 	return animation_sheet_;
 }
 
+const char* animation::get_path() const {
+	return path_;
+}
+
+const collision::bitmask* animation::get_mask() const {
+	return mask_;
+}
+
 Rectangle animation::get_current_frame(){
 	return frame_;
 }
@@ -44,10 +52,18 @@ bool animation::get_play()
 	return play_;
 }
 
+float animation::get_frame_time(){
+	return clip_.frame_time;
+}
+
 void animation::draw_frame(Vector2& pos){
 	DrawTextureRec(animation_sheet_, frame_, pos, WHITE);
 }
 
+void animation::queue_frame(render::render_queue& queue, Vector2& pos, int layer, float sort_y){
+	queue.submit(layer, sort_y, animation_sheet_, frame_, pos);
+}
+
 void animation::next_frame(){
 	frame_.x += frame_width_;
 	++current_frame_;
@@ -115,3 +131,13 @@ void animation::play_animation(){
 void animation::pause_animation(){
 	play_ = false;
 }
+
+void animation::advance(float dt){
+	if (clip_.frame_time <= 0.0 or animation_length_ <= 0) { return; }
+	clip_.elapsed += dt;
+	/**  step as many frames as have elapsed, wrapping around the current animation */
+	auto steps = static_cast<int>(clip_.elapsed / clip_.frame_time);
+	if (steps == 0) { return; }
+	clip_.elapsed -= steps * clip_.frame_time;
+	select_frame((current_frame_ + steps) % animation_length_);
+}
@@ -7,30 +7,40 @@
  *********************************************************************/
 #pragma once
 #include "raylib.h"
+#include "render_queue.h"
+#include "resources.h"
+
+namespace collision {
+	class bitmask;
+}
 
 class animation {
 public:
 	/** constructors and destructors */
 	~animation() = default;
 	animation() = default;
-	animation(const char* path, float frame_width, float frame_height, int animation_length, int num_animations)
-		: animation_sheet_(LoadTexture(path)), frame_width_(frame_width), frame_height_(frame_height),
+	animation(const char* path, float frame_width, float frame_height, int animation_length, int num_animations, float frame_time = 0.0)
+		: animation_sheet_(resources::load_texture(path)), mask_(resources::load_mask(path)), path_(path), frame_width_(frame_width), frame_height_(frame_height),
 			animation_length_(animation_length), num_animations_(num_animations){
 		frame_ = Rectangle{ 0.0, 0.0, frame_width_, frame_height_};
+		clip_.frame_time = frame_time;
 	}
 	animation(const char* path, float frame_width, float frame_height)
-		: animation_sheet_(LoadTexture(path)), frame_width_(frame_width), frame_height_(frame_height),
+		: animation_sheet_(resources::load_texture(path)), mask_(resources::load_mask(path)), path_(path), frame_width_(frame_width), frame_height_(frame_height),
 			animation_length_(0), num_animations_(0){
 		frame_ = Rectangle{ 0.0, 0.0, frame_width_, frame_height_};
 	}
 	animation(const animation& other)
-		: animation_sheet_(other.animation_sheet_), frame_(other.frame_), frame_width_(other.frame_width_),
+		: animation_sheet_(other.animation_sheet_), mask_(other.mask_), path_(other.path_), frame_(other.frame_), frame_width_(other.frame_width_),
 		frame_height_(other.frame_height_), animation_length_(other.animation_length_),
-		num_animations_(other.num_animations_), play_(other.play_) {
+		num_animations_(other.num_animations_), play_(other.play_), current_frame_(other.current_frame_),
+		current_anim_(other.current_anim_), clip_(other.clip_) {
 	};
 	
 	/** accessors */
 	Texture2D get_sheet();
+	const char* get_path() const; // the sheet's path, for the spectator stream
+	const collision::bitmask* get_mask() const; // the whole sheet's, the current frame is its part of it. May be nullptr
 	Rectangle get_current_frame();
 	float get_frame_width();
 	float get_frame_height();
@@ -39,9 +49,11 @@ public:
 	int get_frame_num();
 	int get_animation_num();
 	bool get_play();
+	float get_frame_time();
 
 	/** draw the current frame of the spritesheet */
 	void draw_frame(Vector2& pos); // draw the texture at the current frame
+	void queue_frame(render::render_queue& queue, Vector2& pos, int layer, float sort_y); // submit the current frame to a render queue
 	
 	/** navigate frames in the current animation*/
 	void next_frame(); // go to the next frame (should wrap around the same row) in the current animation
@@ -62,8 +74,19 @@ public:
 	/**  play or pause the current animation */
 	void play_animation();
 	void pause_animation();
+
+	/**  advance the current animation by elapsed time, does nothing for clips without a frame time */
+	void advance(float dt);
 private:
+	/**  timing for the current animation, frames are stepped once per frame_time seconds */
+	struct clip {
+		float frame_time = 0.0; // seconds per frame, 0 means frames are only changed explicitly
+		float elapsed = 0.0; // time accumulated towards the next frame
+	};
+
 	Texture2D animation_sheet_;
+	const collision::bitmask* mask_ = nullptr;
+	const char* path_ = nullptr;
 	Rectangle frame_;
 	float frame_width_;
 	float frame_height_;
@@ -72,4 +95,5 @@ private:
 	bool play_ = false;
 	int current_frame_ = 0;
 	int current_anim_ = 0;
+	clip clip_;
 };
\ No newline at end of file
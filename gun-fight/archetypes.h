@@ -0,0 +1,67 @@
+/*****************************************************************//**
+ * \file   archetypes.h
+ * \brief  compile time descriptors for each obstacle and projectile type.
+ * The tuning for a type lives in one descriptor instead of loose constants,
+ * and every entity keeps a pointer to its own so the game manager can update
+ * each type in its own batch. Attributes that only one type has (lifespans,
+ * alternate sprites) stay in config.h
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "config.h"
+#include <array>
+
+namespace archetype {
+	struct descriptor {
+		int health = 0;
+		int damage = 0;
+		int penetration = 0;
+		int category = -1; // for randomized obstacle generation, -1 is never generated
+		float width = 0.0f;
+		float height = 0.0f;
+		float speed = 0.0f;
+		int animation_length = 0;
+		int animations = 0;
+		float frame_time = 0.0f;
+		const char* path = nullptr; // nullptr when the sprite depends on direction
+	};
+
+	/**  obstacles */
+	inline constexpr descriptor TUMBLEWEED = {
+		.health = 1, .penetration = 0, .category = 0, .width = 64, .height = 64, .speed = 4,
+		.animation_length = 19, .animations = 2, .frame_time = 1.0f / 60.0f, .path = "sprites/tumbleweed.png" };
+	inline constexpr descriptor CACTUS = {
+		.health = 2, .penetration = 1, .category = 1, .width = 90, .height = 150,
+		.animation_length = 2, .animations = 1, .path = "sprites/cactus.png" };
+	inline constexpr descriptor BARREL = {
+		.health = 3, .penetration = 3, .category = 2, .width = 67, .height = 91,
+		.animation_length = 3, .animations = 1, .path = "sprites/barrel.png" };
+	/**  sized for the downward sprite, the upward one is in config.h */
+	inline constexpr descriptor WAGON = {
+		.health = 5, .penetration = 3, .category = 3, .width = 114, .height = 170, .speed = 3.2f,
+		.animation_length = 10, .animations = 1, .frame_time = 1.0f / 60.0f, .path = "sprites/wagon-down.png" };
+	inline constexpr descriptor STRAWMAN = {
+		.health = 1, .penetration = 3, .width = config::GUNMAN_WIDTH, .height = config::GUNMAN_HEIGHT };
+
+	/**  projectiles */
+	inline constexpr descriptor BULLET = {
+		.damage = config::REVOLVER_DAMAGE, .penetration = config::REVOLVER_PENETRATION, .width = 25, .height = 12, .speed = 14 };
+	inline constexpr descriptor RIFLE_BULLET = {
+		.damage = config::RIFLE_DAMAGE, .penetration = config::RIFLE_PENETRATION, .width = 35, .height = 10, .speed = 16 };
+	inline constexpr descriptor DYNAMITE_STICK = {
+		.damage = config::DYNAMITE_DAMAGE, .penetration = config::DYNAMITE_PENETRATION, .width = 16, .height = 32, .speed = 14,
+		.animation_length = 2, .animations = 1, .frame_time = 6.0f / 60.0f, .path = "sprites/dynamite-stick.png" };
+
+	/**  every sheet an entity made or changed during a round can use, loaded before the
+	 * simulation thread starts. The obstacles are loaded when the level is built */
+	inline const std::array<const char*, 22> ROUND_SPRITES = {
+		config::BULLET_LEFT, config::BULLET_RIGHT, config::RIFLE_BULLET_LEFT, config::RIFLE_BULLET_RIGHT,
+		DYNAMITE_STICK.path, config::EXPLOSION_PATH, config::DYNAMITE_MARKER_PATH,
+		config::REVOLVER_PATH, config::RIFLE_PATH, config::DYNAMITE_PATH,
+		config::P1_RIFLE_PATH, config::P2_RIFLE_PATH, config::P1_DEAD_PATH, config::P2_DEAD_PATH,
+		config::STRAWMAN_LEFT_PATH, config::STRAWMAN_RIGHT_PATH,
+		config::HEALTH_PICKUP_PATH, config::ARMOUR_PICKUP_PATH, config::RIFLE_PICKUP_PATH,
+		config::STRAWMAN_PICKUP_PATH, config::AMMO_PICKUP_PATH, config::DYNAMITE_PICKUP_PATH };
+}
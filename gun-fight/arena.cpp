@@ -0,0 +1,84 @@
+/*****************************************************************//**
+ * \file   arena.cpp
+ * \brief  implementation file for the round arena
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "arena.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace {
+	thread_local memory::round_arena* bound = nullptr;
+
+	std::size_t align_up(std::size_t offset, std::size_t alignment) {
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+/**  bump within the current block, moving on to the next block (or a new one) when it is full */
+void* memory::round_arena::allocate(std::size_t bytes, std::size_t alignment){
+	while (block_ < blocks_.size()) {
+		auto base = reinterpret_cast<std::uintptr_t>(blocks_[block_].get());
+		auto start = align_up(base + offset_, alignment) - base;
+		if (start + bytes <= block_sizes_[block_]) {
+			offset_ = start + bytes;
+			used_ += bytes;
+			++live_;
+			return blocks_[block_].get() + start;
+		}
+		++block_;
+		offset_ = 0;
+	}
+	/**  oversized allocations get a block of their own */
+	auto size = std::max(block_size_, bytes + alignment);
+	blocks_.push_back(std::make_unique<std::byte[]>(size));
+	block_sizes_.push_back(size);
+	block_ = blocks_.size() - 1;
+	offset_ = 0;
+	return allocate(bytes, alignment);
+}
+
+void memory::round_arena::deallocate(void* /*p*/, std::size_t /*bytes*/){
+	assert(live_ > 0);
+	--live_;
+}
+
+/**  while anything is still live its memory is not handed out again, the blocks are only rewound
+ * by a reset that finds every allocation freed */
+void memory::round_arena::reset(){
+	assert(live_ == 0 and "an entity outlived its round");
+	if (live_ != 0) {
+		TraceLog(LOG_WARNING, "ARENA: %zu allocations outlived their round, the arena is not rewound", live_);
+		return;
+	}
+	block_ = 0;
+	offset_ = 0;
+	used_ = 0;
+}
+
+std::size_t memory::round_arena::get_used() const {
+	return used_;
+}
+
+std::size_t memory::round_arena::get_live() const {
+	return live_;
+}
+
+std::size_t memory::round_arena::get_capacity() const {
+	auto capacity = std::size_t{ 0 };
+	for (auto size : block_sizes_) {
+		capacity += size;
+	}
+	return capacity;
+}
+
+memory::round_arena* memory::bound_arena(){
+	return bound;
+}
+
+void memory::bind_arena(round_arena* arena){
+	bound = arena;
+}
@@ -0,0 +1,99 @@
+/*****************************************************************//**
+ * \file   arena.h
+ * \brief  header file for the round arena, a bump allocator for entities that
+ * only live for one round (obstacles, pickups, strawmen and projectiles).
+ * Allocating is a pointer bump into the current block and freeing only
+ * updates a count, the memory is reclaimed all at once when the round ends.
+ *
+ * Entities are still held by shared_ptr, make_round builds the object and its
+ * control block together in the arena that is bound to the current thread,
+ * or on the heap when no arena is bound
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "config.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace memory {
+	class round_arena {
+	public:
+		/**  constructors and destructors */
+		~round_arena() = default;
+		explicit round_arena(std::size_t block_size = config::ARENA_BLOCK_SIZE)
+			: block_size_(block_size) {
+		};
+		round_arena(const round_arena&) = delete;
+		round_arena& operator=(const round_arena&) = delete;
+
+		void* allocate(std::size_t bytes, std::size_t alignment);
+		void deallocate(void* p, std::size_t bytes);
+		/**  reclaims everything, every allocation must have been freed. The blocks are kept for the next round.
+		 * If any are still live nothing is reclaimed, their memory is never reused under them */
+		void reset();
+
+		/**  accessors */
+		std::size_t get_used() const; // bytes handed out since the last reset
+		std::size_t get_live() const; // allocations not yet freed
+		std::size_t get_capacity() const;
+	private:
+		std::vector<std::unique_ptr<std::byte[]>> blocks_;
+		std::vector<std::size_t> block_sizes_;
+		std::size_t block_size_;
+		std::size_t block_ = 0; // the block being bumped
+		std::size_t offset_ = 0;
+		std::size_t used_ = 0;
+		std::size_t live_ = 0;
+	};
+
+	/**  standard allocator over a round arena, for allocate_shared */
+	template<typename T>
+	class arena_allocator {
+	public:
+		using value_type = T;
+		explicit arena_allocator(round_arena* arena) : arena_(arena) {};
+		template<typename U>
+		arena_allocator(const arena_allocator<U>& other) : arena_(other.get_arena()) {};
+
+		T* allocate(std::size_t n) {
+			return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(T* p, std::size_t n) {
+			arena_->deallocate(p, n * sizeof(T));
+		}
+		round_arena* get_arena() const { return arena_; }
+
+		template<typename U>
+		bool operator==(const arena_allocator<U>& other) const { return arena_ == other.get_arena(); }
+	private:
+		round_arena* arena_;
+	};
+
+	/**  the arena round scoped entities are built in on this thread, may be nullptr */
+	round_arena* bound_arena();
+	void bind_arena(round_arena* arena);
+
+	/**  binds an arena for the lifetime of the scope */
+	class arena_scope {
+	public:
+		explicit arena_scope(round_arena& arena) : previous_(bound_arena()) { bind_arena(&arena); };
+		~arena_scope() { bind_arena(previous_); };
+		arena_scope(const arena_scope&) = delete;
+		arena_scope& operator=(const arena_scope&) = delete;
+	private:
+		round_arena* previous_;
+	};
+
+	/**  build a round scoped entity in the bound arena */
+	template<typename T, typename... Args>
+	std::shared_ptr<T> make_round(Args&&... args) {
+		auto arena = bound_arena();
+		if (arena == nullptr) {
+			return std::make_shared<T>(std::forward<Args>(args)...);
+		}
+		return std::allocate_shared<T>(arena_allocator<T>(arena), std::forward<Args>(args)...);
+	}
+}
@@ -0,0 +1,211 @@
+/*****************************************************************//**
+ * \file   audio.cpp
+ * \brief  implementation file for the audio mixer
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "audio.h"
+#include "config.h"
+#include "resources.h"
+#include <array>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+	/**  a decoded effect and the aliases it is played through, one per voice so it can overlap itself */
+	struct effect {
+		Sound sound{};
+		std::array<Sound, config::MAX_VOICES> aliases{};
+	};
+
+	struct voice {
+		bool active = false;
+		bool streamed = false;
+		Sound sound{}; // an alias of an effect
+		Music music{}; // one of the opened streams
+		audio::priority level = audio::priority::HIT;
+		unsigned long long started = 0; // play order, the oldest voice is stolen first
+	};
+
+	struct mixer {
+		resources::path_map<effect> effects;
+		resources::path_map<Music> streams;
+		std::array<voice, config::MAX_VOICES> voices{};
+		unsigned long long plays = 0;
+		audio::mixer_stats stats;
+	};
+
+	mixer& state() {
+		static mixer m;
+		return m;
+	}
+
+	effect& load_effect(const char* path) {
+		auto& effects = state().effects;
+		auto it = effects.find(std::string_view(path));
+		if (it == effects.end()) {
+			auto e = effect{ LoadSound(path) };
+			for (auto& alias : e.aliases) {
+				alias = LoadSoundAlias(e.sound);
+			}
+			it = effects.emplace(path, e).first;
+		}
+		return it->second;
+	}
+
+	bool is_playing(const voice& v) {
+		return v.streamed ? IsMusicStreamPlaying(v.music) : IsSoundPlaying(v.sound);
+	}
+
+	void release(voice& v) {
+		if (v.streamed) {
+			StopMusicStream(v.music);
+		}
+		else {
+			StopSound(v.sound);
+		}
+		v = voice{};
+	}
+
+	/**  a free voice, or the one to steal from, nullptr if the sound should be dropped */
+	voice* claim(audio::priority level) {
+		auto& m = state();
+		voice* victim = nullptr;
+		for (auto& v : m.voices) {
+			if (not v.active) { return &v; }
+			if (victim == nullptr or v.level < victim->level or (v.level == victim->level and v.started < victim->started)) {
+				victim = &v;
+			}
+		}
+		if (victim->level > level) {
+			++m.stats.dropped;
+			return nullptr;
+		}
+		++m.stats.stolen;
+		release(*victim);
+		return victim;
+	}
+
+	void start(voice& v, audio::priority level) {
+		auto& m = state();
+		v.active = true;
+		v.level = level;
+		v.started = ++m.plays;
+		++m.stats.played;
+	}
+}
+
+void audio::play(const char* path, priority level){
+	if (resources::is_headless()) { return; }
+	update();
+	auto v = claim(level);
+	if (v == nullptr) { return; }
+	/**  claiming frees at least one alias, every voice holds at most one */
+	for (auto& alias : load_effect(path).aliases) {
+		if (not IsSoundPlaying(alias)) {
+			v->sound = alias;
+			break;
+		}
+	}
+	start(*v, level);
+	PlaySound(v->sound);
+}
+
+void audio::open_stream(const char* path){
+	if (resources::is_headless()) { return; }
+	auto& streams = state().streams;
+	if (streams.find(std::string_view(path)) != streams.end()) { return; }
+	auto music = LoadMusicStream(path);
+	music.looping = false;
+	streams.emplace(path, music);
+}
+
+void audio::play_stream(const char* path, priority level){
+	if (resources::is_headless()) { return; }
+	auto& m = state();
+	auto it = m.streams.find(std::string_view(path));
+	if (it == m.streams.end()) {
+		TraceLog(LOG_WARNING, "AUDIO: %s was not opened, it is not played", path);
+		return;
+	}
+	update();
+	/**  a stream has one read position, a voice still playing it gives it up */
+	for (auto& v : m.voices) {
+		if (v.active and v.streamed and v.music.stream.buffer == it->second.stream.buffer) { release(v); }
+	}
+	auto v = claim(level);
+	if (v == nullptr) { return; }
+	v->streamed = true;
+	v->music = it->second;
+	start(*v, level);
+	SeekMusicStream(v->music, 0.0f);
+	PlayMusicStream(v->music);
+}
+
+void audio::consume(events::subscriber& queue){
+	queue.drain([](const events::event& e) {
+		switch (e.type) {
+		case events::kind::SHOT:
+			/**  both guns share the gunshot, a thrown stick and its explosion have no sound of their own */
+			if (e.target == &archetype::BULLET or e.target == &archetype::RIFLE_BULLET) {
+				play(config::REVOLVER_FIRE_SOUND, priority::WEAPON);
+			}
+			break;
+		case events::kind::RELOAD:
+			play(config::REVOLVER_RELOAD_SOUND, priority::WEAPON);
+			break;
+		case events::kind::HIT:
+			/**  bullets pass through tumbleweeds silently */
+			if (e.target != nullptr and e.target != &archetype::TUMBLEWEED) {
+				play(config::BULLET_HIT_SOUND, priority::HIT);
+			}
+			break;
+		case events::kind::DEATH:
+			play(config::DEATH_SOUND, priority::DEATH);
+			break;
+		default:
+			break;
+		}
+	});
+}
+
+void audio::update(){
+	auto& m = state();
+	m.stats.active = 0;
+	for (auto& v : m.voices) {
+		if (not v.active) { continue; }
+		if (v.streamed) {
+			UpdateMusicStream(v.music);
+		}
+		if (is_playing(v)) {
+			++m.stats.active;
+		}
+		else {
+			release(v);
+		}
+	}
+}
+
+void audio::unload(){
+	auto& m = state();
+	for (auto& v : m.voices) {
+		if (v.active) { release(v); }
+	}
+	for (auto& [path, e] : m.effects) {
+		for (auto& alias : e.aliases) {
+			UnloadSoundAlias(alias);
+		}
+		UnloadSound(e.sound);
+	}
+	m.effects.clear();
+	for (auto& [path, music] : m.streams) {
+		UnloadMusicStream(music);
+	}
+	m.streams.clear();
+}
+
+audio::mixer_stats audio::get_stats(){
+	return state().stats;
+}
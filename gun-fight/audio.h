@@ -0,0 +1,52 @@
+/*****************************************************************//**
+ * \file   audio.h
+ * \brief  header file for the audio mixer. At most config::MAX_VOICES sounds
+ * play at once, when every voice is busy a new sound takes the voice of the
+ * oldest sound with the lowest priority, as long as that priority is not
+ * higher than its own, otherwise it is dropped.
+ *
+ * Short effects are decoded once and played through aliases, so the same
+ * effect can overlap without a second copy of its samples. Long voice lines
+ * are streamed from disk instead of being held in memory, their files are
+ * opened once at startup so playing one only rewinds it.
+ * In headless mode nothing is loaded or played
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "events.h"
+
+namespace audio {
+	/**  higher priorities steal voices from lower ones */
+	enum class priority : int {
+		HIT = 0, // bullets hitting obstacles
+		WEAPON = 1, // firing and reloading
+		DEATH = 2,
+		VOICE = 3 // voice lines
+	};
+
+	/**  counters since the game started, for the profiler overlay */
+	struct mixer_stats {
+		int active = 0; // voices playing now
+		int played = 0;
+		int stolen = 0; // sounds cut short for a higher priority one
+		int dropped = 0; // sounds not played because every voice was busy with higher priorities
+	};
+
+	/**  play a short effect, decoded the first time the path is played */
+	void play(const char* path, priority level);
+	/**  open a long sound for streaming, call once per sound after the audio device is initialised */
+	void open_stream(const char* path);
+	/**  stream a long sound opened with open_stream from the start, a sound already playing is restarted */
+	void play_stream(const char* path, priority level);
+	/**  play the sounds for the gameplay events published since the last call */
+	void consume(events::subscriber& queue);
+	/**  refill the streams and free finished voices, call once per frame */
+	void update();
+	/**  stop everything and unload, call before closing the audio device */
+	void unload();
+
+	mixer_stats get_stats();
+}
@@ -0,0 +1,88 @@
+/*****************************************************************//**
+ * \file   bitmask.cpp
+ * \brief  implementation file for collision masks
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "bitmask.h"
+#include <algorithm>
+#include <cmath>
+
+collision::bitmask::bitmask(int width, int height)
+	: width_(width), height_(height), words_((width + 63) / 64), bits_(std::size_t(words_) * height) {
+}
+
+collision::bitmask collision::bitmask::from_alpha(Image image, unsigned char threshold){
+	auto mask = bitmask(image.width, image.height);
+	auto colours = LoadImageColors(image);
+	if (colours == nullptr) { return mask; }
+	for (auto y = 0; y < image.height; ++y) {
+		for (auto x = 0; x < image.width; ++x) {
+			if (colours[y * image.width + x].a >= threshold) {
+				mask.set(x, y);
+			}
+		}
+	}
+	UnloadImageColors(colours);
+	return mask;
+}
+
+void collision::bitmask::set(int x, int y){
+	bits_[std::size_t(y) * words_ + x / 64] |= std::uint64_t{ 1 } << (x % 64);
+}
+
+bool collision::bitmask::test(int x, int y) const {
+	if (x < 0 or y < 0 or x >= width_ or y >= height_) { return false; }
+	return (bits_[std::size_t(y) * words_ + x / 64] >> (x % 64)) & 1;
+}
+
+/**  the run may straddle two words, the low one is shifted down and the high one up to meet it */
+std::uint64_t collision::bitmask::get_bits(int x, int y) const {
+	if (y < 0 or y >= height_ or x >= width_ or x <= -64) { return 0; }
+	auto row = bits_.data() + std::size_t(y) * words_;
+	auto word = [row, this](int w) { return w >= 0 and w < words_ ? row[w] : std::uint64_t{ 0 }; };
+	/**  a run starting left of the mask reads from the word before, which is empty */
+	auto first = x >= 0 ? x / 64 : -1;
+	auto shift = x - first * 64;
+	auto bits = word(first) >> shift;
+	if (shift != 0) {
+		bits |= word(first + 1) << (64 - shift);
+	}
+	return bits;
+}
+
+int collision::bitmask::get_width() const {
+	return width_;
+}
+
+int collision::bitmask::get_height() const {
+	return height_;
+}
+
+bool collision::pixels_overlap(const bitmask& a, Rectangle a_source, Vector2 a_position,
+	const bitmask& b, Rectangle b_source, Vector2 b_position){
+	auto ax = static_cast<int>(std::lround(a_position.x));
+	auto ay = static_cast<int>(std::lround(a_position.y));
+	auto bx = static_cast<int>(std::lround(b_position.x));
+	auto by = static_cast<int>(std::lround(b_position.y));
+	auto left = std::max(ax, bx);
+	auto right = std::min(ax + static_cast<int>(a_source.width), bx + static_cast<int>(b_source.width));
+	auto top = std::max(ay, by);
+	auto bottom = std::min(ay + static_cast<int>(a_source.height), by + static_cast<int>(b_source.height));
+	/**  where the shared area starts within each sheet */
+	auto a_x = static_cast<int>(a_source.x) + left - ax;
+	auto a_y = static_cast<int>(a_source.y) + top - ay;
+	auto b_x = static_cast<int>(b_source.x) + left - bx;
+	auto b_y = static_cast<int>(b_source.y) + top - by;
+	for (auto row = 0; row < bottom - top; ++row) {
+		for (auto column = 0; column < right - left; column += 64) {
+			auto width = std::min(64, right - left - column);
+			auto in_range = width == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << width) - 1;
+			if (a.get_bits(a_x + column, a_y + row) & b.get_bits(b_x + column, b_y + row) & in_range) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
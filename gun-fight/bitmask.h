@@ -0,0 +1,50 @@
+/*****************************************************************//**
+ * \file   bitmask.h
+ * \brief  header file for collision masks, one bit per pixel of a sprite
+ * sheet set where the pixel is opaque. A mask is built from the sheet's
+ * alpha when it is loaded and covers every frame on the sheet, a frame's
+ * mask is its source rectangle within it.
+ *
+ * Each row is packed into 64-bit words, so two sprites are compared 64
+ * pixels at a time: for every row the rectangles share, the overlapping run
+ * of each mask is shifted into line and the words are ANDed. It is only run
+ * once their rectangles are known to overlap, a bullet is at most a few
+ * rows of one word
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+namespace collision {
+	class bitmask {
+	public:
+		/**  constructors and destructors */
+		~bitmask() = default;
+		bitmask() = default;
+		bitmask(int width, int height);
+
+		/**  opaque where the alpha is at least the threshold */
+		static bitmask from_alpha(Image image, unsigned char threshold);
+
+		void set(int x, int y);
+		bool test(int x, int y) const;
+		/**  the 64 pixels of row y from column x, column x in bit 0. Pixels off the mask are clear */
+		std::uint64_t get_bits(int x, int y) const;
+		int get_width() const;
+		int get_height() const;
+	private:
+		int width_ = 0;
+		int height_ = 0;
+		int words_ = 0; // per row
+		std::vector<std::uint64_t> bits_;
+	};
+
+	/**  true if an opaque pixel of a's frame, drawn at a_position, covers one of b's. Positions are
+	 * rounded to whole pixels the way the sprites are drawn */
+	bool pixels_overlap(const bitmask& a, Rectangle a_source, Vector2 a_position,
+		const bitmask& b, Rectangle b_source, Vector2 b_position);
+}
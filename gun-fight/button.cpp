@@ -16,12 +16,14 @@ void button::draw(Vector2& pos) {
  * \return 
  */
 bool button::update(){
+	auto previous_frame = button_anim_.get_frame_num();
 	if (is_pressed() or is_hovered()) {
 		button_anim_.select_frame(1);
 	}
 	else {
 		button_anim_.select_frame(0);
 	}
+	changed_ = button_anim_.get_frame_num() != previous_frame;
 	return is_pressed();
 }
 
@@ -40,6 +42,11 @@ bool button::is_hovered(){
 	if (CheckCollisionPointRec(mouse_pos, button_rect_)) {
 		return true;
 	}
+	return false;
+}
+
+bool button::has_changed(){
+	return changed_;
 }
 
 Vector2 button::get_position(){
@@ -15,17 +15,19 @@ public:
 	button(const char* path, float width, float height, float x, float y)
 		: button_anim_(animation(path, width, height, 2, 1)), button_rect_(Rectangle{ x, y, width, height }), position_({ x,y }) {}
 	button(const button& other)
-		: button_anim_(other.button_anim_), button_rect_(other.button_rect_), position_(other.position_) {}
+		: button_anim_(other.button_anim_), button_rect_(other.button_rect_), position_(other.position_), changed_(other.changed_) {}
 	
 	/** methods */
 	void draw(Vector2& pos);
 	bool update();
 	bool is_pressed();
 	bool is_hovered();
+	bool has_changed(); // whether the last update changed the drawn frame
 	Vector2 get_position();
 private:
 	animation button_anim_;
 	Rectangle button_rect_;
 	Vector2 position_;
+	bool changed_ = true;
 };
 
@@ -0,0 +1,232 @@
+/*****************************************************************//**
+ * \file   collision.cpp
+ * \brief  implementation file for batched rectangle overlap tests
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "collision.h"
+#include "profiler.h"
+#include <limits>
+
+#if defined(_M_X64) or defined(_M_IX86) or defined(__x86_64__) or defined(__i386__)
+#define GUNFIGHT_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+/**  msvc compiles any intrinsic, gcc and clang have to be told a function may use avx2 */
+#if defined(GUNFIGHT_X86) and (defined(__GNUC__) or defined(__clang__))
+#define GUNFIGHT_AVX2 __attribute__((target("avx2")))
+#else
+#define GUNFIGHT_AVX2
+#endif
+
+namespace {
+	thread_local collision::rect_batch* bound = nullptr;
+	/**  each thread has its own mask, so one batch can be queried by every thread of an update */
+	thread_local std::vector<std::uint64_t> mask;
+
+	/**  a padding rectangle whose left edge is past every query's right edge */
+	constexpr float EMPTY_LEFT = std::numeric_limits<float>::max();
+	constexpr float EMPTY_RIGHT = std::numeric_limits<float>::lowest();
+
+	void overlap_scalar(const Rectangle& q, const float* left, const float* top, const float* right, const float* bottom,
+		std::size_t count, std::uint64_t* mask) {
+		auto q_right = q.x + q.width;
+		auto q_bottom = q.y + q.height;
+		for (std::size_t i = 0; i < count; ++i) {
+			auto hit = q.x < right[i] and q_right > left[i] and q.y < bottom[i] and q_bottom > top[i];
+			mask[i / 64] |= std::uint64_t(hit) << (i % 64);
+		}
+	}
+
+#ifdef GUNFIGHT_X86
+	/**  four rectangles at a time, sse2 is part of every x64 cpu */
+	void overlap_sse2(const Rectangle& q, const float* left, const float* top, const float* right, const float* bottom,
+		std::size_t count, std::uint64_t* mask) {
+		auto q_left = _mm_set1_ps(q.x);
+		auto q_top = _mm_set1_ps(q.y);
+		auto q_right = _mm_set1_ps(q.x + q.width);
+		auto q_bottom = _mm_set1_ps(q.y + q.height);
+		for (std::size_t i = 0; i < count; i += 4) {
+			auto x = _mm_and_ps(_mm_cmplt_ps(q_left, _mm_loadu_ps(right + i)), _mm_cmpgt_ps(q_right, _mm_loadu_ps(left + i)));
+			auto y = _mm_and_ps(_mm_cmplt_ps(q_top, _mm_loadu_ps(bottom + i)), _mm_cmpgt_ps(q_bottom, _mm_loadu_ps(top + i)));
+			mask[i / 64] |= std::uint64_t(_mm_movemask_ps(_mm_and_ps(x, y))) << (i % 64);
+		}
+	}
+
+	/**  eight rectangles at a time */
+	GUNFIGHT_AVX2 void overlap_avx2(const Rectangle& q, const float* left, const float* top, const float* right, const float* bottom,
+		std::size_t count, std::uint64_t* mask) {
+		auto q_left = _mm256_set1_ps(q.x);
+		auto q_top = _mm256_set1_ps(q.y);
+		auto q_right = _mm256_set1_ps(q.x + q.width);
+		auto q_bottom = _mm256_set1_ps(q.y + q.height);
+		for (std::size_t i = 0; i < count; i += 8) {
+			auto x = _mm256_and_ps(_mm256_cmp_ps(q_left, _mm256_loadu_ps(right + i), _CMP_LT_OQ),
+				_mm256_cmp_ps(q_right, _mm256_loadu_ps(left + i), _CMP_GT_OQ));
+			auto y = _mm256_and_ps(_mm256_cmp_ps(q_top, _mm256_loadu_ps(bottom + i), _CMP_LT_OQ),
+				_mm256_cmp_ps(q_bottom, _mm256_loadu_ps(top + i), _CMP_GT_OQ));
+			mask[i / 64] |= std::uint64_t(_mm256_movemask_ps(_mm256_and_ps(x, y))) << (i % 64);
+		}
+	}
+
+	/**  avx2 needs the cpu to have it and the os to save the ymm registers */
+	bool cpu_has_avx2() {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) { return false; }
+		__cpuid(info, 1);
+		auto osxsave = (info[2] & (1 << 27)) != 0;
+		auto avx = (info[2] & (1 << 28)) != 0;
+		if (not osxsave or not avx or (_xgetbv(0) & 6) != 6) { return false; }
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	collision::isa detect() {
+#ifdef GUNFIGHT_X86
+		return cpu_has_avx2() ? collision::isa::AVX2 : collision::isa::SSE2;
+#else
+		return collision::isa::SCALAR;
+#endif
+	}
+}
+
+collision::isa collision::best_isa(){
+	static const auto best = detect();
+	return best;
+}
+
+bool collision::is_supported(isa kernel){
+	return kernel <= best_isa();
+}
+
+const char* collision::get_name(isa kernel){
+	switch (kernel) {
+		case isa::AVX2: return "avx2";
+		case isa::SSE2: return "sse2";
+		default: return "scalar";
+	}
+}
+
+void collision::overlap_mask(isa kernel, const Rectangle& query, const float* left, const float* top, const float* right, const float* bottom,
+	std::size_t count, std::uint64_t* mask){
+	std::fill(mask, mask + (count + 63) / 64, 0);
+	switch (kernel) {
+#ifdef GUNFIGHT_X86
+		case isa::AVX2:
+			overlap_avx2(query, left, top, right, bottom, count, mask);
+			break;
+		case isa::SSE2:
+			overlap_sse2(query, left, top, right, bottom, count, mask);
+			break;
+#endif
+		default:
+			overlap_scalar(query, left, top, right, bottom, count, mask);
+			break;
+	}
+}
+
+/**  rect_batch */
+void collision::rect_batch::gather(const std::vector<std::shared_ptr<entities::entity>>& entities, float margin){
+	PROFILE_ZONE("collision_gather");
+	clear();
+	for (auto& e : entities) {
+		if (not e->is_solid()) {
+			/**  the slot is kept so the indices still match the list, it never overlaps */
+			add(Rectangle{ EMPTY_LEFT, EMPTY_LEFT, 0.0f, 0.0f });
+			continue;
+		}
+		auto r = e->get_rectangle();
+		add(Rectangle{ r.x - margin, r.y - margin, r.width + 2 * margin, r.height + 2 * margin });
+		masks_.back() = e->get_mask();
+		sources_.back() = e->get_source();
+	}
+	margin_ = margin;
+	source_ = &entities;
+}
+
+bool collision::rect_batch::is_exact() const {
+	return margin_ == 0.0f;
+}
+
+/**  the slots past the last rectangle always hold padding, so the kernels can run over whole vectors */
+void collision::rect_batch::add(const Rectangle& rectangle){
+	if (count_ == left_.size()) {
+		pad();
+	}
+	left_[count_] = rectangle.x;
+	top_[count_] = rectangle.y;
+	right_[count_] = rectangle.x + rectangle.width;
+	bottom_[count_] = rectangle.y + rectangle.height;
+	masks_.push_back(nullptr);
+	sources_.push_back(Rectangle{ 0.0f, 0.0f, rectangle.width, rectangle.height });
+	++count_;
+	source_ = nullptr;
+}
+
+void collision::rect_batch::pad(){
+	auto size = left_.size() + LANES;
+	left_.resize(size, EMPTY_LEFT);
+	top_.resize(size, EMPTY_LEFT);
+	right_.resize(size, EMPTY_RIGHT);
+	bottom_.resize(size, EMPTY_RIGHT);
+}
+
+/**  the arrays keep their capacity, cleared slots are reset to padding */
+void collision::rect_batch::clear(){
+	std::fill(left_.begin(), left_.end(), EMPTY_LEFT);
+	std::fill(top_.begin(), top_.end(), EMPTY_LEFT);
+	std::fill(right_.begin(), right_.end(), EMPTY_RIGHT);
+	std::fill(bottom_.begin(), bottom_.end(), EMPTY_RIGHT);
+	masks_.clear();
+	sources_.clear();
+	count_ = 0;
+	source_ = nullptr;
+}
+
+std::size_t collision::rect_batch::size() const {
+	return count_;
+}
+
+Vector2 collision::rect_batch::get_position(std::size_t i) const {
+	return Vector2{ left_[i] + margin_, top_[i] + margin_ };
+}
+
+Rectangle collision::rect_batch::get_source(std::size_t i) const {
+	return sources_[i];
+}
+
+const collision::bitmask* collision::rect_batch::get_mask(std::size_t i) const {
+	return masks_[i];
+}
+
+bool collision::rect_batch::is_gathered_from(const std::vector<std::shared_ptr<entities::entity>>& entities) const {
+	return source_ == &entities and count_ <= entities.size();
+}
+
+/**  only the words holding rectangles are returned, the padding is run through the kernel but never visited */
+const std::vector<std::uint64_t>& collision::rect_batch::overlap(const Rectangle& query) const {
+	auto padded = (count_ + LANES - 1) / LANES * LANES;
+	mask.resize((padded + 63) / 64);
+	overlap_mask(kernel_, query, left_.data(), top_.data(), right_.data(), bottom_.data(), padded, mask.data());
+	mask.resize((count_ + 63) / 64);
+	return mask;
+}
+
+collision::rect_batch* collision::bound_batch(){
+	return bound;
+}
+
+void collision::bind_batch(rect_batch* b){
+	bound = b;
+}
@@ -0,0 +1,176 @@
+/*****************************************************************//**
+ * \file   collision.h
+ * \brief  header file for batched rectangle overlap tests. Instead of calling
+ * CheckCollisionRecs once per entity, the entities' rectangles are packed into
+ * one array per edge and a kernel tests a query rectangle against four or
+ * eight of them per instruction, giving a bitmask of the ones it overlaps.
+ * The kernel is picked when the game starts: AVX2 if the cpu has it, SSE2 on
+ * any other x86 cpu and plain C++ elsewhere.
+ *
+ * The players' update packs the entities as it starts. They move while it
+ * runs, so each packed rectangle is grown by config::COLLISION_MARGIN, more
+ * than anything moves in a frame, and the candidates in the mask are checked
+ * against their current rectangle. The result, and the order the overlaps are
+ * visited in, is the same as testing every entity one at a time.
+ *
+ * The entities' update packs them with no margin. Every entity collides with
+ * where the others were as the update started, so the mask is the answer and
+ * one packed batch is read by every thread of the update.
+ *
+ * Hits that should match the art, a bullet striking a cactus, go on to a
+ * narrow phase once the rectangles overlap: the two sprites' alpha masks are
+ * tested a row of 64 pixels at a time, see bitmask.h. An exact batch keeps
+ * each entity's mask and frame too, so the narrow phase also sees where the
+ * others were as the update started
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "entities.h"
+#include "bitmask.h"
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace collision {
+	enum class isa {
+		SCALAR,
+		SSE2,
+		AVX2
+	};
+
+	/**  the best kernel this cpu runs */
+	isa best_isa();
+	bool is_supported(isa kernel);
+	const char* get_name(isa kernel);
+
+	/**  rectangles are padded to a whole number of the widest vector */
+	inline constexpr std::size_t LANES = 8;
+
+	/**  set bit i of mask if query overlaps rectangle i, with the same strict edges
+	 * as CheckCollisionRecs. The arrays are count long rounded up to LANES, the
+	 * padding never overlaps, and mask is count rounded up to 64 bits long */
+	void overlap_mask(isa kernel, const Rectangle& query, const float* left, const float* top, const float* right, const float* bottom,
+		std::size_t count, std::uint64_t* mask);
+
+	/**  the rectangles of a list of entities, one array per edge */
+	class rect_batch {
+	public:
+		/**  constructors and destructors */
+		~rect_batch() = default;
+		rect_batch() = default;
+		rect_batch(const rect_batch&) = delete;
+		rect_batch& operator=(const rect_batch&) = delete;
+
+		/**  pack every entity's rectangle, grown by the margin on each side */
+		void gather(const std::vector<std::shared_ptr<entities::entity>>& entities, float margin);
+		/**  gathered with no margin, the packed rectangles are the ones collided with */
+		bool is_exact() const;
+		void add(const Rectangle& rectangle);
+		void clear();
+		std::size_t size() const;
+		/**  entities are only ever appended during an update, the ones past size() were not gathered */
+		bool is_gathered_from(const std::vector<std::shared_ptr<entities::entity>>& entities) const;
+		/**  the i'th entity as it was gathered, its position without the margin, its frame and mask */
+		Vector2 get_position(std::size_t i) const;
+		Rectangle get_source(std::size_t i) const;
+		const bitmask* get_mask(std::size_t i) const;
+		/**  the rectangles the query overlaps, one bit each, valid until the next call on this thread */
+		const std::vector<std::uint64_t>& overlap(const Rectangle& query) const;
+	private:
+		void pad();
+
+		std::vector<float> left_;
+		std::vector<float> top_;
+		std::vector<float> right_;
+		std::vector<float> bottom_;
+		std::vector<const bitmask*> masks_;
+		std::vector<Rectangle> sources_;
+		std::size_t count_ = 0;
+		float margin_ = 0.0f;
+		const void* source_ = nullptr;
+		isa kernel_ = best_isa();
+	};
+
+	/**  the batch collision queries use on this thread, may be nullptr */
+	rect_batch* bound_batch();
+	void bind_batch(rect_batch* b);
+
+	/**  gathers the entities into the batch and binds it for the lifetime of the scope,
+	 * a short list is not worth packing and is tested one at a time instead */
+	class batch_scope {
+	public:
+		batch_scope(rect_batch& b, const std::vector<std::shared_ptr<entities::entity>>& entities)
+			: previous_(bound_batch()) {
+			if (entities.size() < config::COLLISION_BATCH_MIN) {
+				bind_batch(nullptr);
+				return;
+			}
+			b.gather(entities, config::COLLISION_MARGIN);
+			bind_batch(&b);
+		};
+		/**  bind a batch already gathered, by another thread of the same update */
+		explicit batch_scope(rect_batch& b) : previous_(bound_batch()) { bind_batch(&b); };
+		~batch_scope() { bind_batch(previous_); };
+		batch_scope(const batch_scope&) = delete;
+		batch_scope& operator=(const batch_scope&) = delete;
+	private:
+		rect_batch* previous_;
+	};
+
+	/**  call visit on every entity overlapping the query, in list order, until it returns false.
+	 * visit is also given the entity's index and, when the entity was taken from an exact batch,
+	 * the batch, which holds the entity's state the query is to be answered against */
+	template<typename visit_fn>
+	void for_each_candidate(const std::vector<std::shared_ptr<entities::entity>>& entities, const Rectangle& query, visit_fn visit) {
+		auto tested = std::size_t{ 0 };
+		if (auto b = bound_batch(); b != nullptr and b->is_gathered_from(entities)) {
+			auto& mask = b->overlap(query);
+			auto exact = b->is_exact();
+			for (std::size_t word = 0; word < mask.size(); ++word) {
+				for (auto bits = mask[word]; bits != 0; bits &= bits - 1) {
+					auto i = word * 64 + std::countr_zero(bits);
+					auto& e = *entities[i];
+					if (exact) {
+						if (not visit(e, i, b)) { return; }
+					}
+					else if (CheckCollisionRecs(query, e.get_rectangle()) and not visit(e, i, nullptr)) { return; }
+				}
+			}
+			tested = b->size();
+		}
+		for (auto i = tested; i < entities.size(); ++i) {
+			auto& e = *entities[i];
+			if (CheckCollisionRecs(query, e.get_rectangle()) and not visit(e, i, nullptr)) { return; }
+		}
+	}
+
+	/**  call visit on every entity overlapping the query, in list order, until it returns false.
+	 * Candidates come from the bound batch when it was gathered from this list, the rest
+	 * are tested one at a time. visit must not make another query. An exact batch is not
+	 * confirmed, the entities' current rectangles may be being moved by other threads */
+	template<typename visit_fn>
+	void for_each_overlap(const std::vector<std::shared_ptr<entities::entity>>& entities, const Rectangle& query, visit_fn visit) {
+		for_each_candidate(entities, query, [&visit](entities::entity& e, std::size_t, const rect_batch*) { return visit(e); });
+	}
+
+	/**  as for_each_overlap with self's rectangle, visiting only the entities an opaque pixel of self
+	 * covers. self is visited too if it is in the list. Either sprite without a mask is hit by its rectangle */
+	template<typename visit_fn>
+	void for_each_hit(const std::vector<std::shared_ptr<entities::entity>>& entities, entities::entity& self, visit_fn visit) {
+		auto self_mask = self.get_mask();
+		auto self_source = self.get_source();
+		auto self_position = self.get_position();
+		for_each_candidate(entities, self.get_rectangle(), [&](entities::entity& e, std::size_t i, const rect_batch* b) {
+			if (self_mask == nullptr or &e == &self) { return visit(e); }
+			auto mask = b != nullptr ? b->get_mask(i) : e.get_mask();
+			if (mask == nullptr) { return visit(e); }
+			auto source = b != nullptr ? b->get_source(i) : e.get_source();
+			auto position = b != nullptr ? b->get_position(i) : e.get_position();
+			return not pixels_overlap(*self_mask, self_source, self_position, *mask, source, position) or visit(e);
+		});
+	}
+}
@@ -55,6 +55,60 @@ namespace config {
 	inline const float HEART_HEIGHT = 60;
 	inline const float HEART_SPACING = 10;
 
+	// frame rates, menus drop to the idle rate while the window is unfocused or minimised
+	inline const int TARGET_FPS = 60;
+	inline const int IDLE_FPS = 10;
+	inline const double INPUT_POLL_INTERVAL = 0.001; // seconds between input polls while waiting for the next frame
+
+	/**  profiler, only built when GUNFIGHT_PROFILE is defined */
+	inline const int PROFILER_OVERLAY_KEY = KEY_F3;
+	inline const int PROFILER_TRACE_KEY = KEY_F4;
+	inline const char* TRACE_PATH = "gun-fight_trace.json";
+	inline const std::size_t PROFILER_FRAME_HISTORY = 240; // frames kept for the percentiles
+	inline const std::size_t PROFILER_MAX_EVENTS = 200000; // zones kept for the trace export
+	inline const double PROFILER_SMOOTHING = 0.1; // weight of the latest frame in the zone averages
+	inline const int PROFILER_OVERLAY_X = 20;
+	inline const int PROFILER_OVERLAY_Y = 170;
+	inline const int PROFILER_OVERLAY_WIDTH = 330;
+	inline const int PROFILER_FONT_SIZE = 10;
+	inline const std::size_t ALLOC_MAX_ZONES = 64; // zones with their own allocation counters
+	inline const std::size_t FRAME_ALLOCATION_BUDGET = 32; // heap allocations allowed in one gameplay frame
+	inline const bool STRICT_ALLOCATION_BUDGET = false; // assert instead of warning when the budget is exceeded
+
+	inline const std::size_t ARENA_BLOCK_SIZE = 256 * 1024; // bytes per round arena block, see arena.h
+
+	inline constexpr std::size_t EVENT_QUEUE_SIZE = 256; // events a subscriber can fall behind by, a power of two, see events.h
+	inline constexpr std::size_t EVENT_MAX_SUBSCRIBERS = 4;
+
+	/**  stress mode, see stress.h for the scenario format */
+	inline const char* STRESS_REPORT_PATH = "stress_report.txt";
+	inline const int STRESS_BOT_FIRE_INTERVAL = 15; // frames between bot shots
+	inline const int STRESS_BOT_RELOAD_INTERVAL = 90;
+	inline const int STRESS_BOT_TURN_INTERVAL = 40; // frames a bot walks one way before turning back
+
+	/**  spectator stream, see spectator.h for the wire format */
+	inline const unsigned short SPECTATOR_PORT = 27015;
+	inline const int SPECTATOR_MAX_SUBSCRIBERS = 32;
+	inline const int SPECTATOR_KEYFRAME_INTERVAL = 60; // ticks between full snapshots, a viewer that lost a packet waits for the next one
+	inline const double SPECTATOR_HELLO_INTERVAL = 1.0; // seconds between a viewer's subscribe messages
+	inline const double SPECTATOR_TIMEOUT = 5.0; // seconds without a subscribe message before a viewer is dropped
+	inline constexpr std::size_t SPECTATOR_MAX_PACKET = 60000; // bytes, under the largest UDP datagram
+
+	/**  dedicated server, see server.h */
+	inline const unsigned short SERVER_PORT = 27016;
+	inline const int SERVER_MATCHES = 64; // matches hosted when no count is given
+	inline const double SERVER_REPORT_INTERVAL = 10.0; // seconds between load reports
+
+	/**  training environments, see gym.h for the observation layout */
+	inline constexpr std::size_t GYM_MAX_PROJECTILES = 16; // the first ones in the entity list are observed
+	inline constexpr std::size_t GYM_MAX_PICKUPS = 4; // on the ground
+	inline constexpr std::size_t GYM_GRID_COLUMNS = 32; // obstacle occupancy over the playable area
+	inline constexpr std::size_t GYM_GRID_ROWS = 16;
+	inline const int GYM_MAX_TICKS = 60 * 60; // a round still going after this long is cut short
+	inline const float GYM_WIN_REWARD = 1.0f; // for the kill, the one killed is given the negative
+	inline const float GYM_HIT_REWARD = 0.1f; // per point of health or armour taken off the other gunman
+	inline const std::size_t GYM_ENV_GRAIN = 4; // environments stepped per range of the pool's loop
+
 	// screen attributes
 	inline const int SCREEN_HEIGHT = 1024;
 	inline const int SCREEN_WIDTH = 1280;
@@ -69,18 +123,29 @@ namespace config {
 	inline const int PLAYABLE_WIDTH = SCREEN_WIDTH;
 	inline const int PLAYABLE_HEIGHT = SCREEN_HEIGHT - HUD_HEIGHT - PLAYABLE_Y;
 
+	// cached hud panels, weapon display followed by up to three hearts / armour
+	inline const int HUD_MARGIN = 115; // from the screen's edge to the outer side of each panel
+	inline const int HUD_WEAPON_WIDTH = 100; // the widest weapon sprite
+	inline const int HUD_MAX_HEARTS = 3;
+	inline const int HUD_PANEL_WIDTH = HUD_WEAPON_WIDTH + HUD_MAX_HEARTS * static_cast<int>(HEART_WIDTH + HEART_SPACING);
+	inline const int HUD_PANEL_HEIGHT = 150;
+	inline const float HUD_PANEL_Y = SCREEN_HEIGHT - 185;
+	inline const float P1_HUD_PANEL_X = HUD_MARGIN;
+	inline const float P2_HUD_PANEL_X = SCREEN_WIDTH - HUD_MARGIN - HUD_PANEL_WIDTH;
+
 	// gunman attributes
 	inline const float GUNMAN_SPEED = 2.2;
 	inline const int GUNMAN_HEALTH = 1;
 	inline const float GUNMAN_ANIMAITON_LENGTH = 15;
 	inline const float GUNMAN_ANIMATIONS = 2;
+	inline const float GUNMAN_FRAME_TIME = 1.0 / 60.0; // seconds per walk frame
 
 	inline const char* P1_PATH = "sprites/gunman-revolver-left.png";
 	inline const char* P2_PATH = "sprites/gunman-revolver-right.png";
 	inline const char* P1_RIFLE_PATH = "sprites/gunman-rifle-left.png";
 	inline const char* P2_RIFLE_PATH = "sprites/gunman-rifle-right.png";
-	inline const float GUNMAN_HEIGHT = 111;
-	inline const float GUNMAN_WIDTH = 52;
+	inline constexpr float GUNMAN_HEIGHT = 111;
+	inline constexpr float GUNMAN_WIDTH = 52;
 
 	inline const char* P1_DEAD_PATH = "sprites/gunman-dead-left.png";
 	inline const char* P2_DEAD_PATH = "sprites/gunman-dead-right.png";
@@ -95,31 +160,44 @@ namespace config {
 	inline const float P2_START_Y = SCREEN_HEIGHT_HALF;
 	inline const int MAX_SCORE = 4;
 
+	// scene transition lengths, in seconds
+	inline const double PRE_ROUND_TIME = 1.1;
+	inline const double POST_ROUND_TIME = 1.5;
+	inline const double GAME_OVER_DELAY = 1.0; // the final frame is held before the winner is shown
+	inline const double GAME_OVER_TIME = 4.05;
+
+	// kill cam, the last ticks of a round are kept and replayed in slow motion after a kill
+	inline constexpr std::size_t KILLCAM_FRAMES = 90; // 1.5 seconds of ticks
+	inline constexpr std::size_t KILLCAM_MAX_SPRITES = 512; // per tick, about 10 kB each
+	inline constexpr std::size_t KILLCAM_MAX_SHEETS = 64;
+	inline const double KILLCAM_SPEED = 0.5; // of real time
+	inline const int KILLCAM_TEXT_SIZE = 40;
+
 	inline const char* P1_WIN_PATH = "sprites/p1-win.png";
 	inline const char* P2_WIN_PATH = "sprites/p2-win.png";
 	inline const float WIN_WIDTH = 650;
 	inline const float WIN_HEIGHT= 100;
 	
 	// need a set of movement_keys and directions
-	inline static auto GUNMAN1_MOVEMENT = std::map<int, Vector2>{
+	inline const auto GUNMAN1_MOVEMENT = std::map<int, Vector2>{
 		{KEY_W, Vector2{0,-GUNMAN_SPEED}},
 		{KEY_A, Vector2{-GUNMAN_SPEED,0}},
 		{KEY_S, Vector2{0,GUNMAN_SPEED}},
 		{KEY_D, Vector2{GUNMAN_SPEED,0}}
 	};
-	inline static auto GUNMAN2_MOVEMENT = std::map<int, Vector2>{
+	inline const auto GUNMAN2_MOVEMENT = std::map<int, Vector2>{
 		{KEY_UP, Vector2{0,-GUNMAN_SPEED}},
 		{KEY_LEFT, Vector2{-GUNMAN_SPEED,0}},
 		{KEY_DOWN, Vector2{0,GUNMAN_SPEED}},
 		{KEY_RIGHT, Vector2{GUNMAN_SPEED,0}}
 	};
 
-	inline static auto GUNMAN1_FIRING = std::pair<int, int>{ KEY_F, KEY_R };
-	inline static auto GUNMAN2_FIRING = std::pair<int, int>{ KEY_COMMA, KEY_PERIOD};
+	inline const auto GUNMAN1_FIRING = std::pair<int, int>{ KEY_F, KEY_R };
+	inline const auto GUNMAN2_FIRING = std::pair<int, int>{ KEY_COMMA, KEY_PERIOD};
 
 
-	inline static int P1_ITEM_KEY = KEY_E;
-	inline static int P2_ITEM_KEY = KEY_SEMICOLON;
+	inline const int P1_ITEM_KEY = KEY_E;
+	inline const int P2_ITEM_KEY = KEY_SEMICOLON;
 	//revolver attributes
 	inline const int REVOLVER_AMMO = 5;
 	inline const int REVOLVER_DAMAGE = 1;
@@ -131,10 +209,7 @@ namespace config {
 	inline const float REVOLVER_HEIGHT = 150;
 	inline const int REVOLVER_FIRE_RATE = 30;
 	
-	// bullet attributes;
-	inline const float BULLET_WIDTH = 25;
-	inline const float BULLET_HEIGHT = 12;
-	inline const float BULLET_SPEED = 14;
+	// bullet sprites, see archetypes.h for the rest
 	inline const char* BULLET_LEFT = "sprites/bullet-1.png";
 	inline const char* BULLET_RIGHT = "sprites/bullet-2.png";
 	// rifle attributes TODO: put in values 
@@ -148,85 +223,65 @@ namespace config {
 	inline const float RIFLE_HEIGHT = REVOLVER_HEIGHT;
 	inline const int RIFLE_FIRE_RATE = 100;
 
-	// rifle bullet attributes
+	// rifle bullet sprites
 	inline const char* RIFLE_BULLET_LEFT = "sprites/rifle-bullet-1.png";
 	inline const char* RIFLE_BULLET_RIGHT = "sprites/rifle-bullet-2.png";
-	inline const float RIFLE_BULLET_SPEED = 16;
-	inline const float RIFLE_BULLET_WIDTH = 35;
-	inline const float RIFLE_BULLET_HEIGHT = 10;
-
-	// dynamite attributes
-	inline const int DYNAMITE_AMMO = 1;
-	inline const int DYNAMITE_DAMAGE = 1;
-	inline const int DYNAMITE_PENETRATION = 1;
-	inline const char* DYNAMITE_PATH = "";
-	inline const float DYNAMITE_ANIMATION_LENGTH = 1;
-	inline const float DYNAMITE_ANIMATIONS = 1;
-	inline const float DYNAMITE_WIDTH = 1;
-	inline const float DYNAMITE_HEIGHT = 1;
-	inline const int DYNAMITE_FIRE_RATE = 1;
 
-	// dynamite stick attributes
-	inline const float DYNAMITE_SPEED = 0.0;
-	inline const float DYNAMITE_STICK_WIDTH = 0.0;
-	inline const float DYNAMITE_STICK_HEIGHT = 0.0;
-	
-	inline const float DYNAMITE_DET_RADIUS = 0.0;
-	inline const float DYNAMITE_TIMER = 0.0; 
+	// dynamite attributes, the stick is in archetypes.h
+	inline const int DYNAMITE_AMMO = 2;
+	inline const int DYNAMITE_DAMAGE = 2;
+	inline const int DYNAMITE_PENETRATION = 3;
+	inline const char* DYNAMITE_PATH = "sprites/dynamite-ammo-display.png";
+	inline const float DYNAMITE_ANIMATION_LENGTH = 6;
+	inline const float DYNAMITE_ANIMATIONS = 1;
+	inline const float DYNAMITE_WIDTH = REVOLVER_WIDTH;
+	inline const float DYNAMITE_HEIGHT = REVOLVER_HEIGHT;
+	inline const int DYNAMITE_FIRE_RATE = 60;
 
-	// obstacle attributes
+	// dynamite throwing, the distance grows while the fire button is held and is shown by the marker
+	inline const float DYNAMITE_MIN_THROW = 100;
+	inline const float DYNAMITE_MAX_THROW = 900;
+	inline const float DYNAMITE_CHARGE_RATE = 12; // pixels added each frame the button is held
+	inline const char* DYNAMITE_MARKER_PATH = "sprites/dynamite-marker.png";
+	inline const float DYNAMITE_MARKER_SIZE = 30;
 
-	// tumbleweed 
-	inline const int TUMBLEWEED_HEALTH = 1;
-	inline const int TUMBLEWEED_CATEGORY = 0;
-	inline const char* TUMBLEWEED_PATH = "sprites/tumbleweed.png";
-	inline const int TUMBLEWEED_PENETRATION = 0;
-	inline const float TUMBLEWEED_WIDTH = 64;
-	inline const float TUMBLEWEED_HEIGHT = 64;
-	inline const float TUMBLEWEED_ANIMATION_LENGTH = 19;
-	inline const float TUMBLEWEED_ANIMATIONS = 2;
-	inline const int TUMBLEWEED_SPEED = 4;
-	inline const int TUMBLEWEED_LIFESPAN_LOWER = 300;
-	inline const int TUMBLEWEED_LIFESPAN_UPPER = 450; // how many frames the tumbleweed will last, incorporate into the update method
-	inline const int TUMBLEWEED_AMPLITUDE = 25;
+	// dynamite stick attributes
+	inline const float DYNAMITE_DET_RADIUS = 120.0;
+	inline const int DYNAMITE_TIMER = 90; // frames from landing until it explodes
+	inline const char* EXPLOSION_PATH = "sprites/explosion.png";
+	inline const int EXPLOSION_ANIMATION_LENGTH = 4;
+	inline const float EXPLOSION_FRAME_TIME = 5.0f / 60.0f;
+	inline const int EXPLOSION_FRAMES = 20; // how long the explosion is shown for
 
+	// spatial grid for radius queries, see spatial.h
+	inline const float SPATIAL_CELL_SIZE = 128;
 
-	// cactus 
+	// batched collision tests, see collision.h. More than anything moves in a frame,
+	// a tumbleweed's bounce can lift it 25 pixels at once
+	inline const float COLLISION_MARGIN = 32;
+	inline const std::size_t COLLISION_BATCH_MIN = 64; // fewer entities than this are quicker to test one at a time than to pack
+	inline const unsigned char MASK_ALPHA_THRESHOLD = 128; // pixels at least this opaque can be hit, see bitmask.h
 
-	inline const int CACTUS_HEALTH = 2;
-	inline const int CACTUS_CATEGORY = 1;
-	inline const char* CACTUS_PATH = "sprites/cactus.png";
-	inline const int CACTUS_PENETRATION = 1;
-	inline const float CACTUS_WIDTH = 90;
-	inline const float CACTUS_HEIGHT = 150;
-	inline const int CACTUS_ANIMATION_LENGTH = 2;
-	inline const int CACTUS_ANIMATIONS = 1;
+	// the entities' update is shared between threads in ranges of this many, see jobs.h
+	inline const std::size_t UPDATE_GRAIN = 512;
 
+	// particle effects, see particles.h
+	inline constexpr std::size_t PARTICLE_CAPACITY = 32768;
+	inline const float PARTICLE_DRAG = 0.94f; // the share of its speed a particle keeps each frame
+	inline const float PARTICLE_GRAVITY = 900.0f; // pixels per second squared, for falling debris
+	inline const float DUST_RATE = 8.0f; // dust particles kicked up each second by a rolling tumbleweed
 
-	// barrel
-	inline const int BARREL_HEALTH = 3;
-	inline const int BARREL_CATEGORY = 2;
-	inline const char* BARREL_PATH = "sprites/barrel.png";
-	inline const int BARREL_PENETRATION = 3;
-	inline const float BARREL_WIDTH = 67;
-	inline const float BARREL_HEIGHT = 91;
-	inline const int BARREL_ANIMATION_LENGTH = 3;
-	inline const int BARREL_ANIMATIONS = 1;
+	// obstacle attributes, the shared ones (health, size, speed, sprites) are in archetypes.h
 
+	// tumbleweed 
+	inline const int TUMBLEWEED_LIFESPAN_LOWER = 300;
+	inline const int TUMBLEWEED_LIFESPAN_UPPER = 450; // how many frames the tumbleweed will last, incorporate into the update method
+	inline const int TUMBLEWEED_AMPLITUDE = 25;
 
-	// wagon
-	inline const int WAGON_HEALTH = 5;
-	inline const int WAGON_CATEGORY = 3;
+	// wagon, sprite for moving up
 	inline const char* WAGON_UP_PATH = "sprites/wagon-up.png";
-	inline const char* WAGON_DOWN_PATH = "sprites/wagon-down.png";
-	inline const int WAGON_PENETRATION = 3;
 	inline const float WAGON_UP_WIDTH = 114;
 	inline const float WAGON_UP_HEIGHT = 134;
-	inline const float WAGON_DOWN_WIDTH = 114;
-	inline const float WAGON_DOWN_HEIGHT = 170;
-	inline const float WAGON_SPEED = 3.2;
-	inline const int WAGON_ANIMATION_LENGTH = 10;
-	inline const int WAGON_ANIMATIONS = 1;
 
 
 	// train 
@@ -236,14 +291,8 @@ namespace config {
 
 
 	// strawman
-	
-	inline const int STRAWMAN_HEALTH = 1;
-	inline const int STRAWMAN_CATEGORY = -1; // so it cannot be accidentally generated 
 	inline const char*  STRAWMAN_LEFT_PATH = "sprites/strawman-left.png";
 	inline const char*  STRAWMAN_RIGHT_PATH = "sprites/strawman-right.png";
-	inline const int STRAWMAN_PENETRATION = 3;
-	inline const float STRAWMAN_WIDTH = GUNMAN_WIDTH;
-	inline const float STRAWMAN_HEIGHT = GUNMAN_HEIGHT;
 
 	// obstacle generation bounds 
 	inline const int OBSTACLE_RANGE_X = SCREEN_WIDTH_HALF - 200;
@@ -278,6 +327,7 @@ namespace config {
 	inline const char* RIFLE_PICKUP_PATH = "sprites/rifle-pickup.png";
 	inline const char* STRAWMAN_PICKUP_PATH = "sprites/strawman-pickup.png";
 	inline const char* AMMO_PICKUP_PATH = "sprites/ammo-pickup.png";
+	inline const char* DYNAMITE_PICKUP_PATH = "sprites/dynamite-pickup.png";
 	inline const double ITEM_SPAWN_DELAY = 10.5; // in seconds, 10.5 for testing purposes, should be longer in reality
 	
 	enum item_codes : int{
@@ -285,12 +335,14 @@ namespace config {
 		ARMOUR = 1,
 		AMMO = 2,
 		RIFLE = 3,
-		STRAWMAN = 4
+		STRAWMAN = 4,
+		DYNAMITE = 5
 		// add more as needed
 	};
 
 
-	// sounds
+	// sounds, voice lines are streamed and the rest are decoded once, see audio.h
+	inline constexpr int MAX_VOICES = 8; // sounds playing at once
 	inline const char* DEATH_SOUND = "sounds/player-death.wav";
 	inline const char* REVOLVER_FIRE_SOUND = "sounds/revolver-shoot.wav";
 	inline const char* REVOLVER_RELOAD_SOUND = "sounds/revolver-reload.wav";
@@ -299,7 +351,7 @@ namespace config {
 		"sounds/this-town.wav",
 		"sounds/fish-in-a-barrel.wav",
 		"sounds/blindfolded.wav", 
-		"sounds/slowest-shooter",
+		"sounds/slowest-shooter.wav",
 		"sounds/got-bullets.wav",
 		 "sounds/for-free.wav",
 		 "sounds/challenge.wav",
@@ -0,0 +1,111 @@
+/*****************************************************************//**
+ * \file   deferred.cpp
+ * \brief  implementation file for deferred effects
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "deferred.h"
+#include "profiler.h"
+#include <algorithm>
+
+namespace {
+	thread_local deferred::buffer* bound = nullptr;
+	/**  the commands of every buffer in the order they are applied, reused between updates */
+	thread_local std::vector<const deferred::command*> merged;
+
+	void run(const deferred::command& c, std::vector<std::shared_ptr<entities::entity>>& entities) {
+		switch (c.type) {
+		case deferred::kind::DAMAGE_GUNMAN:
+			static_cast<entities::gunman*>(c.target)->take_damage(c.amount);
+			break;
+		case deferred::kind::DAMAGE_OBSTACLE:
+			static_cast<entities::obstacle*>(c.target)->take_damage(c.amount);
+			break;
+		case deferred::kind::EXPLODE:
+			static_cast<entities::dynamite_stick*>(c.target)->explode(entities);
+			break;
+		case deferred::kind::PUBLISH:
+			events::publish(c.published);
+			break;
+		}
+	}
+}
+
+void deferred::buffer::set_source(std::size_t index){
+	source_ = static_cast<std::uint32_t>(index);
+}
+
+void deferred::buffer::record(const command& c){
+	commands_.push_back(c);
+	commands_.back().source = source_;
+}
+
+void deferred::buffer::clear(){
+	commands_.clear();
+}
+
+const std::vector<deferred::command>& deferred::buffer::get_commands() const {
+	return commands_;
+}
+
+deferred::buffer* deferred::bound_buffer(){
+	return bound;
+}
+
+void deferred::bind_buffer(buffer* b){
+	bound = b;
+}
+
+void deferred::damage(entities::gunman& target, int amount){
+	if (bound == nullptr) {
+		target.take_damage(amount);
+		return;
+	}
+	bound->record(command{ kind::DAMAGE_GUNMAN, 0, &target, amount });
+}
+
+void deferred::damage(entities::obstacle& target, int amount){
+	if (bound == nullptr) {
+		target.take_damage(amount);
+		return;
+	}
+	bound->record(command{ kind::DAMAGE_OBSTACLE, 0, &target, amount });
+}
+
+void deferred::explode(entities::dynamite_stick& stick, std::vector<std::shared_ptr<entities::entity>>& entities){
+	if (bound == nullptr) {
+		stick.explode(entities);
+		return;
+	}
+	bound->record(command{ kind::EXPLODE, 0, &stick });
+}
+
+void deferred::publish(const events::event& e){
+	if (bound == nullptr) {
+		events::publish(e);
+		return;
+	}
+	bound->record(command{ kind::PUBLISH, 0, nullptr, 0, e });
+}
+
+/**  a buffer's commands are in the order its thread made them, which need not be the order
+ * of the entities, so they are sorted. The sort is stable, an entity's own commands keep their order */
+void deferred::apply(std::vector<buffer>& buffers, std::vector<std::shared_ptr<entities::entity>>& entities){
+	PROFILE_ZONE("apply_deferred");
+	merged.clear();
+	for (auto& b : buffers) {
+		for (auto& c : b.get_commands()) {
+			merged.push_back(&c);
+		}
+	}
+	std::stable_sort(merged.begin(), merged.end(), [](const command* a, const command* b) {
+		return a->source < b->source;
+	});
+	for (auto c : merged) {
+		run(*c, entities);
+	}
+	for (auto& b : buffers) {
+		b.clear();
+	}
+}
@@ -0,0 +1,83 @@
+/*****************************************************************//**
+ * \file   deferred.h
+ * \brief  header file for deferred effects. While the entities update in
+ * parallel each one may only change itself. What it does to others, damage,
+ * setting off an explosion and the events it publishes, is written to the
+ * command buffer bound to its thread, tagged with the index of the entity
+ * that made it. Once every update has finished the buffers are applied on
+ * one thread in the order of those indices, so the outcome is the same
+ * however the entities were shared between threads.
+ *
+ * With no buffer bound the same calls act straight away, so code that runs
+ * outside the parallel update, the players and the merge itself, is unchanged
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "entities.h"
+#include "events.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace deferred {
+	enum class kind : std::uint8_t {
+		DAMAGE_GUNMAN,
+		DAMAGE_OBSTACLE,
+		EXPLODE, // a dynamite stick's fuse ran out, target is the stick
+		PUBLISH
+	};
+
+	struct command {
+		kind type;
+		std::uint32_t source; // the index of the entity whose update made it
+		entities::entity* target = nullptr;
+		int amount = 0;
+		events::event published{};
+	};
+
+	/**  the commands of one range of entities, kept between updates so it stops allocating once warm */
+	class buffer {
+	public:
+		/**  constructors and destructors */
+		~buffer() = default;
+		buffer() = default;
+		buffer(buffer&&) = default;
+		buffer& operator=(buffer&&) = default;
+
+		/**  the entity whose update is running, commands are tagged with it */
+		void set_source(std::size_t index);
+		void record(const command& c);
+		void clear();
+		const std::vector<command>& get_commands() const;
+	private:
+		std::vector<command> commands_;
+		std::uint32_t source_ = 0;
+	};
+
+	/**  the buffer updates on this thread record to, may be nullptr */
+	buffer* bound_buffer();
+	void bind_buffer(buffer* b);
+
+	/**  binds a buffer for the lifetime of the scope */
+	class buffer_scope {
+	public:
+		explicit buffer_scope(buffer& b) : previous_(bound_buffer()) { bind_buffer(&b); };
+		~buffer_scope() { bind_buffer(previous_); };
+		buffer_scope(const buffer_scope&) = delete;
+		buffer_scope& operator=(const buffer_scope&) = delete;
+	private:
+		buffer* previous_;
+	};
+
+	/**  recorded on the bound buffer, or done now when none is bound */
+	void damage(entities::gunman& target, int amount);
+	void damage(entities::obstacle& target, int amount);
+	void explode(entities::dynamite_stick& stick, std::vector<std::shared_ptr<entities::entity>>& entities);
+	void publish(const events::event& e);
+
+	/**  apply every buffer's commands ordered by the entity that made them, then clear the buffers.
+	 * Events are published to the bus bound on the calling thread */
+	void apply(std::vector<buffer>& buffers, std::vector<std::shared_ptr<entities::entity>>& entities);
+}
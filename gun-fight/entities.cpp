@@ -34,6 +34,14 @@ animation entities::entity::get_animation(){
 	return animation_;
 }
 
+Rectangle entities::entity::get_source(){
+	return animation_.get_current_frame();
+}
+
+const collision::bitmask* entities::entity::get_mask() const {
+	return animation_.get_mask();
+}
+
 void entities::entity::set_animation(animation anim){
 	animation_ = anim;
 }
@@ -41,6 +49,12 @@ void entities::entity::set_animation(animation anim){
 const char* entities::entity::get_path() const {
 	return path_;
 }
+const archetype::descriptor* entities::entity::get_archetype() const {
+	return archetype_;
+}
+bool entities::entity::is_solid() const {
+	return solid_;
+}
 bool entities::entity::get_remove() {
 	return remove_;
 }
@@ -51,9 +65,15 @@ void entities::entity::set_remove(bool b) {
 }
 
 /**  other behaviour */
-void entities::entity::draw() {
-	// TODO eventually chagne to animation
-	animation_.draw_frame(position_);
+void entities::entity::draw(render::render_queue& queue) {
+	/**  sort by the base of the sprite so lower entities are drawn in front */
+	animation_.queue_frame(queue, position_, get_layer(), position_.y + animation_.get_frame_height());
+}
+int entities::entity::get_layer() const {
+	return render::ACTORS;
+}
+void entities::entity::animate(float dt) {
+	animation_.advance(dt);
 }
 
 /** operator overloads */
@@ -64,6 +84,7 @@ entities::entity& entities::entity::operator=(const entities::entity& other) {
 
 	position_ = other.position_;
 	path_ = other.path_;
+	archetype_ = other.archetype_;
 	return *this;
 }
 bool entities::entity::operator<(entity& other){
@@ -11,6 +11,7 @@
 #include "raymath.h"
 #include "animation.h"
 #include "config.h"
+#include "archetypes.h"
 #include "utility.h"
 #include <vector>
 #include <string>
@@ -32,7 +33,7 @@ namespace entities {
 		};
 		// copy constructor
 		entity(const entity& other)
-			: position_(other.position_), path_(other.path_), remove_(other.remove_), animation_(other.animation_) {
+			: position_(other.position_), path_(other.path_), remove_(other.remove_), solid_(other.solid_), animation_(other.animation_), archetype_(other.archetype_) {
 		};
 		
 		/**  accessors */
@@ -41,10 +42,14 @@ namespace entities {
 		float get_x() const;
 		float get_y() const;
 		const char* get_path() const;
+		const archetype::descriptor* get_archetype() const; // nullptr for gunmen, weapons and pickups
+		bool is_solid() const; // false once it is left out of the collision batch and the spatial grid
 
 		Vector2 get_position();
 		Rectangle get_rectangle();
 		animation get_animation();
+		Rectangle get_source(); // the current frame on the sheet
+		const collision::bitmask* get_mask() const; // the sheet's collision mask, may be nullptr
 
 		/**  modifiers */
 		void set_animation(animation anim);
@@ -56,7 +61,9 @@ namespace entities {
 		bool operator<(entity& other);
 		
 		/**  other behaivours */
-		virtual void draw(); 
+		virtual void draw(render::render_queue& queue); 
+		virtual int get_layer() const;
+		virtual void animate(float dt); // advance the animation by elapsed time
 		virtual bool update(std::vector<std::shared_ptr<entity>>& entities) = 0;
 		virtual bool collide(entity& other) = 0;
 	protected:
@@ -64,6 +71,8 @@ namespace entities {
 		animation animation_ = animation();
 		const char* path_;
 		bool remove_ = false; // should the entity be removed from the game
+		bool solid_ = true;
+		const archetype::descriptor* archetype_ = nullptr;
 	};
 
 
@@ -77,7 +86,7 @@ namespace entities {
 		/**  constructors and destructors */
 		gunman(float x, float y, const char* path, int health, int direction)
 			: entity(x, y, path), health_(health), direction_(direction), armour_(0) {
-			animation_ = animation(path, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS);
+			animation_ = animation(path, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS, config::GUNMAN_FRAME_TIME);
 		};
 		gunman(const gunman& other)
 			:entity(other), health_(other.health_), direction_(other.direction_), armour_(0) {
@@ -98,12 +107,14 @@ namespace entities {
 		/**  entity overridden methods */
 		bool update(std::vector<std::shared_ptr<entity>>& entities) override;
 		bool collide(entity& other) override;
+		void animate(float dt) override;
 
 
 	private:
 		int health_;
 		const int direction_; // left facing is 1, right facing is -1 
 		int armour_;
+		bool moving_ = false; // the walk animation only plays while moving
 	};
 
 
@@ -115,8 +126,9 @@ namespace entities {
 	class obstacle : public entity {
 	public:
 		/**  constructors and destructors */
-		obstacle(float x, float y, const char* path, int health, int category, int penetration)
-			: entity(x, y, path), health_(health), obstacle_category_(category), penetration_(penetration) {
+		obstacle(float x, float y, const char* path, const archetype::descriptor& type)
+			: entity(x, y, path), health_(type.health), obstacle_category_(type.category), penetration_(type.penetration) {
+			archetype_ = &type;
 		};
 		// overload the copy constructor 
 		obstacle(const obstacle& other)
@@ -142,8 +154,8 @@ namespace entities {
 	class moveable_obstacle : public obstacle {
 	public:
 		/** constructors and destructors */
-		moveable_obstacle(float x, float y, const char* path, int health, int category, int penetration, float movement_x, float movement_y)
-			: obstacle(x, y, path, health, category, penetration), movement_speed_(Vector2{ movement_x, movement_y }) {
+		moveable_obstacle(float x, float y, const char* path, const archetype::descriptor& type, float movement_x, float movement_y)
+			: obstacle(x, y, path, type), movement_speed_(Vector2{ movement_x, movement_y }) {
 		}
 		moveable_obstacle(const moveable_obstacle& other)
 			: obstacle(other), movement_speed_(other.movement_speed_), frames_existed_(other.frames_existed_) {
@@ -164,11 +176,11 @@ namespace entities {
 
 	};
 	/**  definition of cactus obstacle class */
-	class cactus : public obstacle {
+	class cactus final : public obstacle {
 	public:
 		cactus(float x, float y)
-			: obstacle(x, y, config::CACTUS_PATH, config::CACTUS_HEALTH, config::CACTUS_CATEGORY, config::CACTUS_PENETRATION) {
-			animation_ = animation(path_, config::CACTUS_WIDTH, config::CACTUS_HEIGHT, config::CACTUS_ANIMATION_LENGTH, config::CACTUS_ANIMATIONS);
+			: obstacle(x, y, archetype::CACTUS.path, archetype::CACTUS) {
+			animation_ = animation(path_, archetype::CACTUS.width, archetype::CACTUS.height, archetype::CACTUS.animation_length, archetype::CACTUS.animations);
 		};
 		cactus(const cactus& other)
 			: obstacle(other) {
@@ -177,11 +189,11 @@ namespace entities {
 	private:
 	};
 	/**  definition of barrel obstacle class */
-	class barrel : public obstacle {
+	class barrel final : public obstacle {
 	public:
 		barrel(float x, float y)
-			: obstacle(x, y, config::BARREL_PATH, config::BARREL_HEALTH, config::BARREL_CATEGORY, config::BARREL_PENETRATION) {
-			animation_ = animation(path_, config::BARREL_WIDTH, config::BARREL_HEIGHT, config::BARREL_ANIMATION_LENGTH, config::BARREL_ANIMATIONS);
+			: obstacle(x, y, archetype::BARREL.path, archetype::BARREL) {
+			animation_ = animation(path_, archetype::BARREL.width, archetype::BARREL.height, archetype::BARREL.animation_length, archetype::BARREL.animations);
 		};
 		barrel(const barrel& other)
 			: obstacle(other) {
@@ -191,11 +203,11 @@ namespace entities {
 		
 	};
 
-	class strawman : public obstacle {
+	class strawman final : public obstacle {
 	public:
 		strawman(float x, float y, const char* path, int direction)
-			: obstacle(x, y, path, config::STRAWMAN_HEALTH, config::STRAWMAN_CATEGORY, config::STRAWMAN_PENETRATION), direction_(direction) {
-			animation_ = animation(path, config::STRAWMAN_WIDTH, config::STRAWMAN_HEIGHT);
+			: obstacle(x, y, path, archetype::STRAWMAN), direction_(direction) {
+			animation_ = animation(path, archetype::STRAWMAN.width, archetype::STRAWMAN.height);
 		};
 		strawman(const strawman& other)
 			: obstacle(other), direction_(other.direction_) {
@@ -206,30 +218,34 @@ namespace entities {
 		int direction_;
 	};
 	/** definition of wagon obstacle class, can move vertically on the y-axis */
-	class wagon : public moveable_obstacle {
+	class wagon final : public moveable_obstacle {
 	public:
 		wagon(float x, float y, float movement_x, float movement_y)
-			: moveable_obstacle(x, y, config::WAGON_UP_PATH, config::WAGON_HEALTH, config::WAGON_CATEGORY, config::WAGON_PENETRATION, movement_x, movement_y) {
+			: moveable_obstacle(x, y, config::WAGON_UP_PATH, archetype::WAGON, movement_x, movement_y) {
 
 			// animation_ = animation(); depends on direction
-			animation_ = animation(config::WAGON_DOWN_PATH, config::WAGON_DOWN_WIDTH, config::WAGON_DOWN_HEIGHT, config::WAGON_ANIMATION_LENGTH, config::WAGON_ANIMATIONS);
+			down_ = animation(archetype::WAGON.path, archetype::WAGON.width, archetype::WAGON.height, archetype::WAGON.animation_length, archetype::WAGON.animations, archetype::WAGON.frame_time);
+			up_ = animation(config::WAGON_UP_PATH, config::WAGON_UP_WIDTH, config::WAGON_UP_HEIGHT, archetype::WAGON.animation_length, archetype::WAGON.animations, archetype::WAGON.frame_time);
+			animation_ = down_;
 		};
 		wagon(const wagon& other)
-			: moveable_obstacle(other) {
+			: moveable_obstacle(other), down_(other.down_), up_(other.up_) {
 		};
 
 		/**  overridden behaviours  */
-		void draw() override;
 		void change_direction() override;
+		bool update(std::vector<std::shared_ptr<entity>>& entities) override;
 	private:
-
+		/**  both directions are loaded when the wagon is built, turning happens during the parallel update */
+		animation down_;
+		animation up_;
 	};
-	class tumbleweed : public moveable_obstacle {
+	class tumbleweed final : public moveable_obstacle {
 	public:
 		tumbleweed(float x, float y)
-			: moveable_obstacle(x, y, config::TUMBLEWEED_PATH, config::TUMBLEWEED_HEALTH, config::TUMBLEWEED_CATEGORY, config::TUMBLEWEED_PENETRATION, config::TUMBLEWEED_SPEED, 0.0),
+			: moveable_obstacle(x, y, archetype::TUMBLEWEED.path, archetype::TUMBLEWEED, archetype::TUMBLEWEED.speed, 0.0),
 			baseline_(y), lifespan_(util::generate_random_int(config::TUMBLEWEED_LIFESPAN_LOWER, config::TUMBLEWEED_LIFESPAN_UPPER)) {
-			animation_ = animation(path_, config::TUMBLEWEED_WIDTH, config::TUMBLEWEED_HEIGHT, config::TUMBLEWEED_ANIMATION_LENGTH, config::TUMBLEWEED_ANIMATIONS);
+			animation_ = animation(path_, archetype::TUMBLEWEED.width, archetype::TUMBLEWEED.height, archetype::TUMBLEWEED.animation_length, archetype::TUMBLEWEED.animations, archetype::TUMBLEWEED.frame_time);
 		};
 		tumbleweed(const tumbleweed& other)
 			: moveable_obstacle(other), baseline_(other.baseline_), lifespan_(other.lifespan_) {
@@ -239,7 +255,6 @@ namespace entities {
 		bool move(std::vector<std::shared_ptr<entity>>& entities) override;
 		void change_direction() override;
 		bool update(std::vector<std::shared_ptr<entity>>& entities) override;
-		void draw() override;
 	private:
 		float baseline_; // for sine wave movement
 		int lifespan_;
@@ -250,8 +265,9 @@ namespace entities {
 	class projectile : public entity {
 	public:
 		/**  constructors and destructors  */
-		projectile(float x, float y, const char* path, float speed, float direction, int damage, int penetration)
-			: entity(x, y, path), speed_direction_({ speed, direction }), damage_(damage), penetration_(penetration) {
+		projectile(float x, float y, const char* path, const archetype::descriptor& type, float direction)
+			: entity(x, y, path), speed_direction_({ type.speed, direction }), damage_(type.damage), penetration_(type.penetration) {
+			archetype_ = &type;
 		};
 
 		projectile(const projectile& other)
@@ -263,10 +279,12 @@ namespace entities {
 		int get_penetration();
 		Vector2 get_speed_direction() const;
 		bool penetrate(const int& obstacle_penetration);
+		void lead(float frames); // move ahead by a fraction of a frame, for shots fired mid frame
 
 		/**  overridden behaviours */
 		bool update(std::vector<std::shared_ptr<entity>>& entities) override; // this is where projectile movement will occur
 		bool collide(entity& other) override;
+		int get_layer() const override;
 
 		/**  operator overloads */
 		bool operator==(const entity& other) override;
@@ -277,12 +295,12 @@ namespace entities {
 		Vector2 speed_direction_;
 	};
 	/** class definition for revolver bullets */
-	class bullet : public projectile {
+	class bullet final : public projectile {
 	public:
 		/**  constructors and destructors */
 		bullet(float x, float y, const char* path, float direction)
-			: projectile(x, y, path, config::BULLET_SPEED, direction, config::REVOLVER_DAMAGE, config::REVOLVER_PENETRATION) {
-			animation_ = animation(path, config::BULLET_WIDTH, config::BULLET_HEIGHT);
+			: projectile(x, y, path, archetype::BULLET, direction) {
+			animation_ = animation(path, archetype::BULLET.width, archetype::BULLET.height);
 		};
 
 		bullet(const bullet& other)
@@ -293,11 +311,11 @@ namespace entities {
 	private:
 	};
 	/**  class definition for rifle bullets - TODO implement */
-	class rifle_bullet : public projectile {
+	class rifle_bullet final : public projectile {
 	public:
 		rifle_bullet(float x, float y, const char* path, float direction)
-			: projectile(x, y, path, config::RIFLE_BULLET_SPEED, direction, config::RIFLE_DAMAGE, config::RIFLE_PENETRATION) {
-			animation_ = animation(path, config::RIFLE_BULLET_WIDTH, config::RIFLE_BULLET_HEIGHT); // TODO fill in
+			: projectile(x, y, path, archetype::RIFLE_BULLET, direction) {
+			animation_ = animation(path, archetype::RIFLE_BULLET.width, archetype::RIFLE_BULLET.height); // TODO fill in
 		};
 		rifle_bullet(const rifle_bullet& other)
 			: projectile(other) {
@@ -305,22 +323,34 @@ namespace entities {
 
 	private:
 	};
-	/**  class definition for dynamite sticks = TODO implement */
-	class dynamite_stick : public projectile {
+	/**  class definition for dynamite sticks. A stick flies to where it was thrown,
+	 * sits there until its fuse runs out then damages everything within its radius */
+	class dynamite_stick final : public projectile {
 	public:
-		dynamite_stick(float x, float y, const char* path, float direction, int throw_power)
-			: projectile(x, y, path, config::DYNAMITE_SPEED, direction, config::DYNAMITE_DAMAGE, config::DYNAMITE_PENETRATION), throw_power_(throw_power) {
-			animation_ = animation(path, config::DYNAMITE_STICK_WIDTH,
-				config::DYNAMITE_STICK_HEIGHT, 1, 1); // placeholder, replace when animation is done
+		dynamite_stick(float x, float y, const char* path, float direction, float throw_distance)
+			: projectile(x, y, path, archetype::DYNAMITE_STICK, direction), throw_distance_(throw_distance) {
+			animation_ = animation(path, archetype::DYNAMITE_STICK.width, archetype::DYNAMITE_STICK.height,
+				archetype::DYNAMITE_STICK.animation_length, archetype::DYNAMITE_STICK.animations, archetype::DYNAMITE_STICK.frame_time);
 		}
 		dynamite_stick(const dynamite_stick& other)
-			: projectile(other), throw_power_(other.throw_power_) {
+			: projectile(other), det_radius_(other.det_radius_), det_timer_(other.det_timer_), throw_distance_(other.throw_distance_),
+			explosion_timer_(other.explosion_timer_) {
 		};
+
+		/**  light the fuse to nothing, used when caught in another explosion */
+		void detonate();
+		bool is_exploding() const;
+		/**  damage everything within the radius, run in the merge after the parallel update */
+		void explode(std::vector<std::shared_ptr<entity>>& entities);
+
+		bool update(std::vector<std::shared_ptr<entity>>& entities) override;
+		bool collide(entity& other) override;
+		int get_layer() const override;
 	private:
-		// need a detonation radius and timer 
 		float det_radius_ = config::DYNAMITE_DET_RADIUS;
-		int det_timer_ = config::DYNAMITE_TIMER; // in frames 
-		int throw_power_; // essentially a speed coefficient that affects movement
+		int det_timer_ = config::DYNAMITE_TIMER; // in frames, counted once the stick lands
+		float throw_distance_; // pixels left to fly
+		int explosion_timer_ = 0; // frames the explosion has been shown for, 0 before it explodes
 	};
 
 
@@ -331,45 +361,18 @@ namespace entities {
 	class weapon : public entity {
 	public:
 		/**
-		 * weapon state pattern for firing and reloading, state reflects whether the weapon is currently
-		 loaded or unloaded.
+		 * weapon state for firing and reloading, state reflects whether the weapon is currently
+		 loaded or unloaded. Held by value so firing and reloading never allocate
 		 */
-		class weapon_state {
-		public:
-			virtual ~weapon_state() = default;
-			weapon_state() = default;
-			virtual bool fire(weapon* w) = 0;
-			virtual bool reload(weapon* w) = 0;
-			virtual std::unique_ptr<weapon_state> clone() = 0;
-		protected:
-		};
-		class loaded_state : public weapon_state {
-		public:
-			loaded_state() {};
-			loaded_state(const loaded_state& other) {};
-			bool fire(weapon* w) override;
-			bool reload(weapon* w) override;
-			std::unique_ptr<weapon_state> clone() override;
-
-		private:
-		};
-		class unloaded_state : public weapon_state {
-		public:
-			unloaded_state() {};
-			unloaded_state(const unloaded_state& other) {};
-			bool fire(weapon* w) override;
-			bool reload(weapon* w) override;
-			std::unique_ptr<weapon_state> clone() override;
-		private:
-		};
+		enum class weapon_state { LOADED, UNLOADED };
 
 		/**  constructors and destructors */
 		weapon(float x, float y, const char* path, int ammo, int fire_rate)
 			:entity(x, y, path), ammo_(ammo), fire_rate_(fire_rate) {
 		};
 		weapon(const weapon& other)
-			: entity(other), ammo_(other.ammo_),
-			fire_rate_(other.fire_rate_), state_(other.state_->clone()) {
+			: entity(other), ammo_(other.ammo_), cooldown_(other.cooldown_),
+			fire_rate_(other.fire_rate_), state_(other.state_) {
 		};
 
 		/**  unique accessors and behaviours */
@@ -393,10 +396,14 @@ namespace entities {
 		void draw(int x, int y);
 
 	protected:
+		/**  state transitions shared by every weapon */
+		bool fire_round(); // loaded to unloaded, once the cooldown has passed
+		bool load_round(); // unloaded to loaded, uses one of the spare ammo
+
 		int ammo_;
 		int cooldown_ = 0;
 		int fire_rate_;
-		std::unique_ptr<weapon_state> state_ = std::make_unique<loaded_state>(loaded_state());
+		weapon_state state_ = weapon_state::LOADED;
 	};
 	/**  class definition for revolver, the default weapon*/
 	class revolver : public weapon {
@@ -444,16 +451,18 @@ namespace entities {
 
 	private:
 	};
-	/**  class definition for dynamite weapon TODO implement */
+	/**  class definition for dynamite, thrown instead of fired. The throw is charged
+	 * while the fire button is held and released with it, the marker shows where it will land */
 	class dynamite : public weapon {
 	public:
 		dynamite(float x, float y, const char* path)
 			: weapon(x, y, path, config::DYNAMITE_AMMO, config::DYNAMITE_FIRE_RATE) {
 			animation_ = animation(config::DYNAMITE_PATH, config::DYNAMITE_WIDTH, config::DYNAMITE_HEIGHT,
 				config::DYNAMITE_ANIMATION_LENGTH, config::DYNAMITE_ANIMATIONS);
+			marker_ = animation(config::DYNAMITE_MARKER_PATH, config::DYNAMITE_MARKER_SIZE, config::DYNAMITE_MARKER_SIZE);
 		};
 		dynamite(const dynamite& other)
-			: weapon(other) {
+			: weapon(other), charge_(other.charge_), marker_(other.marker_) {
 		};
 		std::shared_ptr<entities::projectile> create_bullet(float x, float y, int direction) override;
 		bool fire() override;
@@ -461,8 +470,16 @@ namespace entities {
 		void replenish() override;
 		bool update(std::vector<std::shared_ptr<entity>>& entities) override;
 		bool collide(entity& other) override;
+
+		/**  throwing */
+		bool can_charge(); // loaded and cooled down
+		void charge(); // a frame of the fire button being held
+		bool is_charging() const;
+		float get_landing_x(int direction) const; // where a throw released now lands
+		void draw_marker(render::render_queue& queue, int direction);
 	private:
-		static std::pair<Sound, Sound> fire_reload_sounds_;
+		float charge_ = 0.0f; // the distance of the throw, 0 when not charging
+		animation marker_;
 	};
 
 
@@ -470,60 +487,34 @@ namespace entities {
 
 
 
-
 	/**  superclass definition for items that can be picked up and used by the player */
 	class pickup : public entity {
 	public:
 		/**
-		 * pickup state - alters update behaviour based on whether the item is on the ground or
-		 * picked up by the player
+		 * pickup state - whether the item is on the ground or picked up by the player,
+		 * held by value
 		 */
-		class pickup_state {
-		public:
-			pickup_state() = default;
-			~pickup_state() = default;
-			pickup_state(const pickup_state& other) = default;
-			virtual std::unique_ptr<pickup_state>  clone() = 0;
-			virtual bool update(pickup* p) = 0;
-		private:
-		};
-		class on_ground : public pickup_state {
-		public:
-			~on_ground() = default;
-			on_ground() = default;
-			on_ground(const on_ground& other) = default;
-			std::unique_ptr<pickup_state> clone() override;
-			bool update(pickup* p) override;
-		private:
-		};
-		class in_inventory : public pickup_state {
-		public:
-			~in_inventory() = default;
-			in_inventory() = default;
-			in_inventory(const in_inventory& other) = default;
-			std::unique_ptr<pickup_state> clone() override;	
-			bool update(pickup* p) override;
-
-		private:
-
-		};
+		enum class pickup_state { ON_GROUND, IN_INVENTORY };
 
 		pickup(float x, float y, const char* path)
-			: entity(x, y, path), state_(std::make_unique<on_ground>(on_ground())) {
+			: entity(x, y, path) {
 			animation_ = animation(path, config::ITEM_WIDTH, config::ITEM_HEIGHT);
 		};
 		pickup(const pickup& other)
-			:entity(other), state_(other.state_->clone()) {
+			:entity(other), state_(other.state_) {
 		};
 		bool update(std::vector<std::shared_ptr<entity>>& entities) override;
 		bool collide(entity& other) override;
 		void draw(float x, float y);
+		int get_layer() const override;
+		void pick_up();
+		pickup_state get_state() const;
 		virtual void use(std::shared_ptr<gunman>& gunman, std::shared_ptr<weapon>& weapon, std::vector<std::shared_ptr<entity>>& entities) = 0; // for health changes
 
 		bool operator==(const entity& other) override;
 
 	protected:
-		std::unique_ptr<pickup_state> state_;
+		pickup_state state_ = pickup_state::ON_GROUND;
 	};
 	class health_pickup : public pickup {
 	public:
@@ -539,6 +530,8 @@ namespace entities {
 			: pickup(x, y, path) {
 		};
 		void use(std::shared_ptr<gunman>& gunman, std::shared_ptr<weapon>& weapon, std::vector<std::shared_ptr<entity>>& entities) override; // for health changes
+		/**  the empty item slot, shared by every player. Built on first use, after the window is created */
+		static const std::shared_ptr<pickup>& sentinel();
 	private:
 	};
 	class rifle_pickup : public pickup {
@@ -0,0 +1,67 @@
+/*****************************************************************//**
+ * \file   events.cpp
+ * \brief  implementation file for the gameplay event bus
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "events.h"
+#include <cassert>
+
+namespace {
+	thread_local events::bus* bound = nullptr;
+}
+
+/**  the publisher owns head_, acquiring tail_ makes sure the slot has been read before it is reused */
+bool events::subscriber::push(const event& e){
+	auto head = head_.load(std::memory_order_relaxed);
+	if (head - tail_.load(std::memory_order_acquire) == ring_.size()) {
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	ring_[head & (ring_.size() - 1)] = e;
+	head_.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+bool events::subscriber::poll(event& e){
+	auto tail = tail_.load(std::memory_order_relaxed);
+	if (tail == head_.load(std::memory_order_acquire)) {
+		return false;
+	}
+	e = ring_[tail & (ring_.size() - 1)];
+	tail_.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+std::size_t events::subscriber::get_dropped() const {
+	return dropped_.load(std::memory_order_relaxed);
+}
+
+events::subscriber& events::bus::subscribe(){
+	auto index = count_.load();
+	assert(index < subscribers_.size() and "too many event subscribers");
+	count_.store(index + 1);
+	return subscribers_[index];
+}
+
+void events::bus::publish(const event& e){
+	auto count = count_.load(std::memory_order_acquire);
+	for (std::size_t i = 0; i < count; ++i) {
+		subscribers_[i].push(e);
+	}
+}
+
+events::bus* events::bound_bus(){
+	return bound;
+}
+
+void events::bind_bus(bus* b){
+	bound = b;
+}
+
+void events::publish(const event& e){
+	if (bound != nullptr) {
+		bound->publish(e);
+	}
+}
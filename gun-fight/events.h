@@ -0,0 +1,106 @@
+/*****************************************************************//**
+ * \file   events.h
+ * \brief  header file for the gameplay event bus. The simulation publishes
+ * small events (shots, hits, deaths...) instead of playing sounds or
+ * swapping sprites itself, and the audio and presentation layers consume
+ * them afterwards. Without a consumer the events are simply dropped, so the
+ * simulation can run, or be replayed, without any audio or drawing.
+ *
+ * Every subscriber has its own single producer single consumer ring, so
+ * publishing and polling never lock and a subscriber can be drained on a
+ * different thread to the one publishing. Publishing into a full ring drops
+ * the event rather than waiting
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "archetypes.h"
+#include "config.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace events {
+	enum class kind : std::uint8_t {
+		SHOT,
+		RELOAD,
+		HIT, // a projectile hit an obstacle or a gunman
+		DEATH,
+		ITEM_USED,
+		OBSTACLE_DESTROYED,
+		EXPLOSION // a dynamite stick went off, target is the stick
+	};
+
+	struct event {
+		kind type;
+		std::uint8_t player = 0; // 1 or 2 for events caused by or happening to a player, 0 otherwise
+		const archetype::descriptor* target = nullptr; // the obstacle hit or destroyed, the projectile of a shot
+		Vector2 position{};
+	};
+
+	/**  one subscriber's ring, written by the publishing thread and read by the subscriber's */
+	class subscriber {
+	public:
+		/**  constructors and destructors */
+		~subscriber() = default;
+		subscriber() = default;
+		subscriber(const subscriber&) = delete;
+		subscriber& operator=(const subscriber&) = delete;
+
+		bool push(const event& e); // false if the ring is full
+		bool poll(event& e); // false if there is nothing to read
+
+		/**  handle every event published so far */
+		template<typename handler_fn>
+		void drain(handler_fn handle) {
+			auto e = event{};
+			while (poll(e)) {
+				handle(e);
+			}
+		}
+		std::size_t get_dropped() const;
+	private:
+		static_assert((config::EVENT_QUEUE_SIZE & (config::EVENT_QUEUE_SIZE - 1)) == 0, "the queue size must be a power of two");
+		std::array<event, config::EVENT_QUEUE_SIZE> ring_{};
+		alignas(64) std::atomic<std::size_t> head_ = 0; // next slot to write, only the publisher stores
+		alignas(64) std::atomic<std::size_t> tail_ = 0; // next slot to read, only the subscriber stores
+		std::atomic<std::size_t> dropped_ = 0;
+	};
+
+	class bus {
+	public:
+		/**  constructors and destructors */
+		~bus() = default;
+		bus() = default;
+		bus(const bus&) = delete;
+		bus& operator=(const bus&) = delete;
+
+		/**  subscribe before the simulation starts publishing */
+		subscriber& subscribe();
+		void publish(const event& e);
+	private:
+		std::array<subscriber, config::EVENT_MAX_SUBSCRIBERS> subscribers_;
+		std::atomic<std::size_t> count_ = 0;
+	};
+
+	/**  the bus the simulation publishes to on this thread, may be nullptr */
+	bus* bound_bus();
+	void bind_bus(bus* b);
+
+	/**  binds a bus for the lifetime of the scope */
+	class bus_scope {
+	public:
+		explicit bus_scope(bus& b) : previous_(bound_bus()) { bind_bus(&b); };
+		~bus_scope() { bind_bus(previous_); };
+		bus_scope(const bus_scope&) = delete;
+		bus_scope& operator=(const bus_scope&) = delete;
+	private:
+		bus* previous_;
+	};
+
+	/**  publish to the bound bus, dropped if no bus is bound */
+	void publish(const event& e);
+}
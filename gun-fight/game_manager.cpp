@@ -6,9 +6,25 @@
  * \date   February 2025
  *********************************************************************/
 #include "game_manager.h"
+#include "profiler.h"
+#include "audio.h"
+#include "jobs.h"
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <type_traits>
+void game_manager::add_entity(std::shared_ptr<entities::entity> entity){
+	game_entities_.push_back(std::move(entity));
+}
+
 /**  erase entities that should be removed */
 void game_manager::remove_entities(){
+	PROFILE_ZONE("remove_entities");
+	/**  the erase keeps the order, so the runs stay in place */
+	partitioned_ = std::min(partitioned_, game_entities_.size());
+	partitioned_ -= std::count_if(game_entities_.begin(), game_entities_.begin() + partitioned_, [](auto& e) {
+		return e->get_remove();
+		});
 	auto new_end = std::remove_if(game_entities_.begin(), game_entities_.end(), [](auto& e) {
 		return e->get_remove();
 		});
@@ -18,63 +34,339 @@ void game_manager::remove_entities(){
 /**  remove all entities apart from the player characters */
 void game_manager::clear_entities(){
 	game_entities_.clear(); 
+	partitioned_ = 0;
 	game_entities_.push_back(player_1_.get_gunman());
 	game_entities_.push_back(player_2_.get_gunman());
 }
 
-/**  update all entities */
+namespace {
+	/**  the archetypes with their own batch in update_entities */
+	constexpr auto BATCHED = std::array<const archetype::descriptor*, 7>{
+		&archetype::WAGON, &archetype::TUMBLEWEED, &archetype::CACTUS, &archetype::BARREL,
+		&archetype::STRAWMAN, &archetype::BULLET, &archetype::RIFLE_BULLET };
+
+	/**  where each run starts, the last is the end of the list */
+	using run_starts = std::array<std::size_t, BATCHED.size() + 2>;
+
+	/**  the run an entity is kept in, BATCHED.size() for the rest */
+	std::size_t run_of(const entities::entity& e) {
+		return static_cast<std::size_t>(std::find(BATCHED.begin(), BATCHED.end(), e.get_archetype()) - BATCHED.begin());
+	}
+
+	/**  merge the entities pushed since the last update into their runs. Both sorts are stable,
+	 * so each run stays in the order its entities were added */
+	run_starts partition(std::vector<std::shared_ptr<entities::entity>>& entities, std::size_t& partitioned) {
+		auto by_run = [](auto& a, auto& b) { return run_of(*a) < run_of(*b); };
+		partitioned = std::min(partitioned, entities.size());
+		if (partitioned < entities.size()) {
+			std::stable_sort(entities.begin() + partitioned, entities.end(), by_run);
+			std::inplace_merge(entities.begin(), entities.begin() + partitioned, entities.end(), by_run);
+			partitioned = entities.size();
+		}
+		auto starts = run_starts{};
+		for (std::size_t run = 1; run < starts.size() - 1; ++run) {
+			starts[run] = static_cast<std::size_t>(std::partition_point(entities.begin() + starts[run - 1], entities.end(),
+				[run](auto& e) { return run_of(*e) < run; }) - entities.begin());
+		}
+		starts.back() = entities.size();
+		return starts;
+	}
+
+	/**  update the entities of one archetype's run that fall in the range. T is final, so
+	 * the update call is resolved at compile time and can be inlined into the loop */
+	template<typename T>
+	void update_batch(std::size_t run, const run_starts& starts, std::vector<std::shared_ptr<entities::entity>>& entities,
+		std::size_t begin, std::size_t end, deferred::buffer& commands) {
+		static_assert(std::is_final_v<T>, "batched types must be final");
+		for (auto i = std::max(begin, starts[run]); i < std::min(end, starts[run + 1]); ++i) {
+			commands.set_source(i);
+			static_cast<T&>(*entities[i]).update(entities);
+		}
+	}
+
+	/**  one range of the entities, a loop over each run it covers. The rest are updated through
+	 * the virtual call, apart from the gunmen which the players update */
+	void update_range(std::vector<std::shared_ptr<entities::entity>>& entities, const run_starts& starts,
+		std::size_t begin, std::size_t end, deferred::buffer& commands) {
+		update_batch<entities::wagon>(0, starts, entities, begin, end, commands);
+		update_batch<entities::tumbleweed>(1, starts, entities, begin, end, commands);
+		update_batch<entities::cactus>(2, starts, entities, begin, end, commands);
+		update_batch<entities::barrel>(3, starts, entities, begin, end, commands);
+		update_batch<entities::strawman>(4, starts, entities, begin, end, commands);
+		update_batch<entities::bullet>(5, starts, entities, begin, end, commands);
+		update_batch<entities::rifle_bullet>(6, starts, entities, begin, end, commands);
+		for (auto i = std::max(begin, starts[BATCHED.size()]); i < end; ++i) {
+			auto& e = entities[i];
+			if (dynamic_cast<entities::gunman*>(e.get()) == nullptr) {
+				commands.set_source(i);
+				e->update(entities);
+			}
+		}
+	}
+}
+
+/**  update all entities against the state they were in as the tick started. Every entity
+ * collides with the rectangles packed here and changes only itself, so the ranges can run on
+ * any thread in any order. What they do to each other is applied afterwards, in list order */
 void game_manager::update_entities(){
-	// the gunman should be in the entity list but not
+	PROFILE_ZONE("update_entities");
+	auto scope = events::bus_scope(bus_);
+	auto grid = spatial::grid_scope(grid_);
+	auto starts = partition(game_entities_, partitioned_);
+	collision_batch_.gather(game_entities_, 0.0f);
+
+	auto ranges = std::max<std::size_t>(1, (game_entities_.size() + config::UPDATE_GRAIN - 1) / config::UPDATE_GRAIN);
+	if (deferred_.size() < ranges) {
+		deferred_.resize(ranges);
+	}
+	jobs::parallel_for(game_entities_.size(), config::UPDATE_GRAIN, [this, &starts](std::size_t begin, std::size_t end) {
+		auto& commands = deferred_[begin / config::UPDATE_GRAIN];
+		auto collisions = collision::batch_scope(collision_batch_);
+		auto recording = deferred::buffer_scope(commands);
+		update_range(game_entities_, starts, begin, end, commands);
+	});
+	deferred::apply(deferred_, game_entities_);
+}
+
+/**  advance every entity's animation by the frame time, in one pass after the simulation */
+void game_manager::animate_entities(float dt){
 	for (auto& e : game_entities_) {
-		auto gunman_ptr = dynamic_cast<entities::gunman*>(e.get());
-		if (gunman_ptr == nullptr) {
-			e->update(game_entities_);
-		}
+		e->animate(dt);
 	}
 }
 
-/**  draw elemenets of the game */
+/**  draw elemenets of the game, recorded and drawn on the same thread */
 void game_manager::draw_game(){
+	present_events();
+	record_frame();
+	draw_frame();
+}
+
+/**  record what the renderer needs from the simulation as it stands, and hand it over */
+void game_manager::record_frame(){
+	PROFILE_ZONE("record_frame");
+	auto& frame = frames_.back();
+	frame.sprites.clear();
+	draw_players(frame.sprites);
+	draw_entities(frame.sprites);
+	frame.players = { player_1_.get_view(), player_2_.get_view() };
+	frame.scores = { player_1_.get_score(), player_2_.get_score() };
+	frame.dust.clear();
+	for (auto& e : game_entities_) {
+		if (e->get_archetype() != &archetype::TUMBLEWEED) { continue; }
+		auto r = e->get_rectangle();
+		frame.dust.push_back(Vector2{ r.x + r.width / 2, r.y + r.height });
+	}
+	frame.entity_count = game_entities_.size();
+	frames_.publish();
+}
+
+/**  draw the latest recorded frame, everything is queued then drawn in layer order */
+void game_manager::draw_frame(){
+	auto& frame = frames_.latest();
 	draw_background();
-	draw_players();
-	draw_scores();
-	draw_entities();
+	draw_scores(frame.scores);
+	player_1_.draw_hud(frame.players[0], render_queue_);
+	player_2_.draw_hud(frame.players[1], render_queue_);
+	render_queue_.submit(frame.sprites);
+	{
+		PROFILE_ZONE("flush");
+		render_queue_.flush();
+	}
+	draw_effects(frame);
+	drawn_entities_ = frame.entity_count;
 }
 
-void game_manager::draw_entities(){
+void game_manager::draw_entities(render::render_queue& queue){
+	PROFILE_ZONE("draw_entities");
 	for (auto& e : game_entities_) {
-		e->draw();
+		/**  the gunmen are drawn with their players */
+		if (e == player_1_.get_gunman() or e == player_2_.get_gunman()) { continue; }
+		e->draw(queue);
 	}
 }
 
-void game_manager::draw_scores(){
-	auto pos = Vector2{ player_1_.get_draw_x(), 10.0};
-	scores_.select_frame(player_1_.get_score());
-	scores_.draw_frame(pos);
+/**  burst the events published since the last frame, kick up dust behind the rolling
+ * tumbleweeds, then move and draw every particle over the sprites */
+void game_manager::draw_effects(const render::snapshot& frame){
+	effect_events_.drain([this](const events::event& e) {
+		particles_.emit(e);
+	});
+	auto dt = GetFrameTime();
+	dust_due_ += dt * config::DUST_RATE;
+	auto dust = static_cast<int>(dust_due_);
+	dust_due_ -= dust;
+	for (auto i = 0; i < dust; ++i) {
+		for (auto& position : frame.dust) {
+			particles_.emit(particles::effect::DUST, position, Color{ 190, 160, 110, 160 });
+		}
+	}
+	particles_.update(dt);
+	particles_.draw();
+}
+
+void game_manager::draw_scores(std::pair<int, int> scores){
+	if (not header_panel_.is_rendered() or scores != drawn_scores_) {
+		header_panel_.begin_render();
+		auto pos = Vector2{ 0.0, 0.0 };
+		header_.draw_frame(pos);
+
+		pos = Vector2{ player_1_.get_draw_x(), 10.0};
+		scores_.select_frame(scores.first);
+		scores_.draw_frame(pos);
 
-	pos = Vector2{ player_2_.get_draw_x(), 10.0};
-	scores_.select_frame(player_2_.get_score());
-	scores_.draw_frame(pos);
+		pos = Vector2{ player_2_.get_draw_x(), 10.0};
+		scores_.select_frame(scores.second);
+		scores_.draw_frame(pos);
+		header_panel_.end_render();
+		drawn_scores_ = scores;
+	}
+	header_panel_.draw(render_queue_);
 }	
 
 void game_manager::update_players(){
+	PROFILE_ZONE("update_players");
+	/**  bullets and strawmen are built in the round arena */
+	auto scope = memory::arena_scope(arenas_[current_arena_]);
+	auto events_scope = events::bus_scope(bus_);
+	auto collisions = collision::batch_scope(collision_batch_, game_entities_);
 	if (player_1_.is_dead()) {
+		events::publish({ events::kind::DEATH, player_1_.get_id(), nullptr, player_1_.get_gunman()->get_position() });
 		player_2_.increase_score();
 		end_round();
 	}
 	else if (player_2_.is_dead()) {
+		events::publish({ events::kind::DEATH, player_2_.get_id(), nullptr, player_2_.get_gunman()->get_position() });
 		player_1_.increase_score();
 		end_round();
 	}
+	/**  whoever pressed fire first this frame is updated first, player 1 wins exact ties */
+	else if (player_2_.get_fire_time(input_) < player_1_.get_fire_time(input_)) {
+		player_2_.update_player(game_entities_, input_);
+		player_1_.update_player(game_entities_, input_);
+	}
 	else {
-		player_1_.update_player(game_entities_);
-		player_2_.update_player(game_entities_);
+		player_1_.update_player(game_entities_, input_);
+		player_2_.update_player(game_entities_, input_);
+	}
+}
+
+void game_manager::update_player(std::uint8_t id){
+	PROFILE_ZONE("update_players");
+	auto scope = memory::arena_scope(arenas_[current_arena_]);
+	auto events_scope = events::bus_scope(bus_);
+	auto collisions = collision::batch_scope(collision_batch_, game_entities_);
+	get_player(id).update_player(game_entities_, input_);
+}
+
+/**  apply the visible effects of this frame's events that the simulation keeps, the dead pose for now */
+void game_manager::present_events(){
+	presentation_events_.drain([this](const events::event& e) {
+		if (e.type == events::kind::HIT and e.target == nullptr) {
+			last_hits_[e.player == player_1_.get_id() ? 0 : 1] = e.position;
+		}
+		if (e.type == events::kind::DEATH) {
+			(e.player == player_1_.get_id() ? player_1_ : player_2_).show_death();
+			if (killcam_ != nullptr) {
+				killcam_->mark_kill(last_hits_[e.player == player_1_.get_id() ? 0 : 1]);
+			}
+		}
+	});
+	/**  nothing is drawn headless, so no particles are made */
+	if (resources::is_headless()) {
+		effect_events_.drain([](auto&) {});
 	}
 }
 
-void game_manager::draw_players(){
-	player_1_.draw_player();
-	player_2_.draw_player();
+void game_manager::enable_killcam(){
+	killcam_ = std::make_unique<killcam::recorder>();
+}
+
+void game_manager::record_killcam(){
+	if (killcam_ == nullptr) { return; }
+	killcam_->record(game_entities_);
+}
+
+double game_manager::get_killcam_length() const {
+	return killcam_ != nullptr ? killcam_->get_length() : 0.0;
+}
+
+/**  the replay over the background and scores, the hud is left out */
+void game_manager::draw_killcam(double elapsed){
+	if (killcam_ == nullptr) { return; }
+	draw_background();
+	draw_scores({ player_1_.get_score(), player_2_.get_score() });
+	killcam_->draw(elapsed, render_queue_);
+	render_queue_.flush();
+	auto width = MeasureText("KILL CAM", config::KILLCAM_TEXT_SIZE);
+	DrawText("KILL CAM", config::SCREEN_WIDTH_HALF - width / 2, config::PLAYABLE_Y + config::KILLCAM_TEXT_SIZE, config::KILLCAM_TEXT_SIZE, RAYWHITE);
+}
+
+void game_manager::enable_spectators(std::uint16_t port){
+	spectators_ = std::make_unique<spectator::broadcaster>(port);
+}
+
+void game_manager::broadcast_state(){
+	if (spectators_ == nullptr) { return; }
+	PROFILE_ZONE("broadcast_state");
+	spectators_->broadcast(game_entities_, get_match_state());
+}
+
+spectator::match_state game_manager::get_match_state(){
+	return spectator::match_state{ player_1_.get_score(), player_2_.get_score(), round_num_ };
+}
+
+void game_manager::draw_players(render::render_queue& queue){
+	PROFILE_ZONE("draw_players");
+	player_1_.draw_player(queue);
+	player_2_.draw_player(queue);
+}
+
+/**  draw the winning player over the final scene */
+void game_manager::draw_game_over(){
+	draw_background();
+	draw_scores({ player_1_.get_score(), player_2_.get_score() });
+	draw_players(render_queue_);
+	player_1_.draw_hud(player_1_.get_view(), render_queue_);
+	player_2_.draw_hud(player_2_.get_view(), render_queue_);
+	draw_win();
+	render_queue_.flush();
+}
+
+render::render_stats game_manager::get_render_stats() const {
+	return render_queue_.get_stats();
+}
+
+input::input_queue& game_manager::get_input(){
+	return input_;
+}
+
+void game_manager::seed(unsigned int seed){
+	random_.seed(seed);
+}
+
+memory::round_arena& game_manager::get_arena(){
+	return arenas_[current_arena_];
+}
+
+events::subscriber& game_manager::get_audio_events(){
+	return audio_events_;
+}
+
+const std::vector<std::shared_ptr<entities::entity>>& game_manager::get_entities() const {
+	return game_entities_;
+}
+
+std::size_t game_manager::get_entity_count() const {
+	return game_entities_.size();
+}
+
+std::size_t game_manager::get_drawn_entity_count() const {
+	return drawn_entities_;
+}
+
+player& game_manager::get_player(std::uint8_t id){
+	return id == 1 ? player_1_ : player_2_;
 }
 
 int game_manager::get_round_num(){
@@ -85,15 +377,14 @@ int game_manager::get_frame_count(){
 	return frame_count_;
 }
 
-/**  draw the background and the hud frame */
+/**  draw the background and the hud frame, the header is drawn with the scores */
 void game_manager::draw_background() {
+	PROFILE_ZONE("draw_background");
 	auto pos = Vector2{ config::PLAYABLE_X, config::PLAYABLE_Y };
-	background_.draw_frame(pos);
+	background_.queue_frame(render_queue_, pos, render::BACKGROUND, 0.0);
 
-	pos = Vector2{ 0.0,0.0 };
-	header_.draw_frame(pos);
 	pos = Vector2{ 0.0,config::PLAYABLE_HEIGHT};
-	footer_.draw_frame(pos);
+	footer_.queue_frame(render_queue_, pos, render::HUD, pos.y);
 }
 
 void game_manager::increment_round_count(){
@@ -106,6 +397,7 @@ void game_manager::increment_frame_count(){
 
 void game_manager::reset_level(){
 	game_entities_.clear();
+	partitioned_ = 0;
 }
 
 void game_manager::reset_scores(){
@@ -113,40 +405,39 @@ void game_manager::reset_scores(){
 	player_2_.set_score(0);
 }
 
+/**  a level pregenerated with the old random numbers is thrown away, its arena is reset when it next becomes the round's */
+void game_manager::restart(unsigned int seed){
+	random_.seed(seed);
+	next_level_.reset();
+	round_num_ = 1;
+	last_spawn_time = -config::ITEM_SPAWN_DELAY;
+	reset_scores();
+	input_.clear();
+	build_level();
+}
+
 void game_manager::end_round() {
 	// wait a few seconds to let the dead animation appears	
-	Sound s = LoadSound(config::DEATH_SOUND);
-	PlaySound(s);
 	round_over_ = true;
-	last_spawn_time  = 0;
+	last_spawn_time = -config::ITEM_SPAWN_DELAY;
 }
 
-bool game_manager::is_round_over(){
-	return round_over_;
+void game_manager::revive_players(){
+	player_1_.reset_player();
+	player_2_.reset_player();
+	round_over_ = false;
 }
 
-void game_manager::pre_round(){
-	auto start = GetTime();
-	auto draw = LoadTexture(config::DRAW_PATH);
-	/** before each round, draw the round intro texture */
-	while (GetTime() - start < 1.1) {
-		BeginDrawing();
-		draw_game();
-		auto draw_x = config::SCREEN_WIDTH_HALF - (config::DRAW_WIDTH / 2);
-		auto draw_y = config::SCREEN_HEIGHT_HALF - (config::DRAW_HEIGHT / 2);
-		DrawTexture(draw, draw_x, draw_y, WHITE);	
-		EndDrawing();
-	}
+bool game_manager::is_round_over(){
+	return round_over_;
 }
 
-void game_manager::post_round(){
-	auto start = GetTime();
-	/** draw only the gunmen and the background, makes time for voicelines */
-	while (GetTime() - start < 1.5) {
-		BeginDrawing();
-		draw_game();
-		EndDrawing();
-	}
+/** draw the round intro texture over the game */
+void game_manager::draw_round_intro(){
+	auto draw = resources::load_texture(config::DRAW_PATH);
+	auto draw_x = config::SCREEN_WIDTH_HALF - (config::DRAW_WIDTH / 2);
+	auto draw_y = config::SCREEN_HEIGHT_HALF - (config::DRAW_HEIGHT / 2);
+	DrawTexture(draw, draw_x, draw_y, WHITE);
 }
 
 bool game_manager::game_over(){
@@ -155,57 +446,82 @@ bool game_manager::game_over(){
 
 void game_manager::draw_win(){
 	if (player_1_.get_score() == config::MAX_SCORE) {
-		player_1_.draw_win();
+		player_1_.draw_win(render_queue_);
 	}
 	else if (player_2_.get_score() == config::MAX_SCORE) {
-		player_2_.draw_win();
+		player_2_.draw_win(render_queue_);
 	}
 }
 
 void game_manager::play_voiceline(){
-	auto index = util::generate_random_int(0, voicelines_.size() - 1);
-	PlaySound(voicelines_[index]);
+	auto random = util::generator_scope(random_);
+	auto index = util::generate_random_int(0, config::VOICE_LINES.size() - 1);
+	audio::play_stream(config::VOICE_LINES[index], audio::priority::VOICE);
+}
+
+/**  generate the obstacles for the next round ahead of time */
+void game_manager::pregenerate_level(){
+	auto random = util::generator_scope(random_);
+	/**  pick random types of obstacles to generate, 0 is no obstalces */
+	auto category = util::generate_random_num(0.0, 3.0);
+	if (category <= 0.5) { category = 0; }
+	else { category = ceil(category); }
+	/**  determine the number of obstacles to generate */
+	auto obstacles_to_generate = 2 * ((round_num_ + 1) % 4) + 1;
+	auto scope = memory::arena_scope(arenas_[1 - current_arena_]);
+	next_level_ = std::make_unique<level::level>(level::level(category, obstacles_to_generate));
+
+	/**  build the environment by placing obstacles randomly */
+	next_level_->build_level();
 }
 
 /**  build the level for each round */
 void game_manager::build_level(){
+	PROFILE_ZONE("build_level");
 	/** reset the players, remove obstacles */
 	player_1_.reset_player();
 	player_2_.reset_player();
 	clear_entities();
+	particles_.clear();
+	if (killcam_ != nullptr) {
+		killcam_->clear();
+	}
+
+	/**  the level is usually generated during the post round, otherwise do it now */
+	if (next_level_ == nullptr) {
+		pregenerate_level();
+	}
+
+	/**  nothing from the last round is left, its arena is reclaimed and the level's arena becomes the round's */
+	arenas_[current_arena_].reset();
+	current_arena_ = 1 - current_arena_;
 	
 	/** reset counters  */
 	frame_count_ = 0;
 	++round_num_;
 	round_over_ = false;
 
-	/**  pick random types of obstacles to generate, 0 is no obstalces */
-	auto category = util::generate_random_num(0.0, 3.0);
-	if (category <= 0.5) { category = 0; }
-	else { category = ceil(category); }
-	/**  determine the number of obstacles to generate */
-	auto obstacles_to_generate = 2 * (round_num_ % 4) + 1;
-	auto builder = std::make_unique<level::level>(level::level(category, obstacles_to_generate));
-
-	/**  build the environment by placing obstacles randomly */
-	builder->build_level();
-	auto& level_entities = builder->get_level_entities();
+	auto& level_entities = next_level_->get_level_entities();
 
 	/**  transfer obstacles to game manager */
 	while (not level_entities.empty()) {
 		auto it = level_entities.extract(level_entities.begin());
 		game_entities_.push_back(std::move(it.value()));
 	}
+	next_level_.reset();
 }
 /** every 14 seconds, spawn an item on either side of the map */
 void game_manager::spawn_items(){
-	// check time
-	auto time = GetTime();
+	PROFILE_ZONE("spawn_items");
+	auto scope = memory::arena_scope(arenas_[current_arena_]);
+	auto random = util::generator_scope(random_);
+	// check the simulated time, so headless games spawn at the same rate
+	auto time = static_cast<double>(frame_count_) / config::TARGET_FPS;
 	if (time - last_spawn_time >= config::ITEM_SPAWN_DELAY) {
 		last_spawn_time = time;
 		// pick two random items (use an enum)
-		auto item_1_type = util::generate_random_int(config::item_codes::HEALTH, config::item_codes::STRAWMAN);  // currently either health or armour 
-		auto item_2_type = util::generate_random_int(config::item_codes::HEALTH, config::item_codes::STRAWMAN);  // currently either health or armour 
+		auto item_1_type = util::generate_random_int(config::item_codes::HEALTH, config::item_codes::DYNAMITE);
+		auto item_2_type = util::generate_random_int(config::item_codes::HEALTH, config::item_codes::DYNAMITE);
 
 
 		// generate the two positions
@@ -216,37 +532,43 @@ void game_manager::spawn_items(){
 		// spawn an item for p1
 		switch (item_1_type) {
 			case config::item_codes::HEALTH:
-				game_entities_.push_back(std::make_shared<entities::health_pickup>(item_1_x, item_1_y, config::HEALTH_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::health_pickup>(item_1_x, item_1_y, config::HEALTH_PICKUP_PATH));
 				break;
 			case config::item_codes::ARMOUR:
-				game_entities_.push_back(std::make_shared<entities::armour_pickup>(item_1_x, item_1_y, config::ARMOUR_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::armour_pickup>(item_1_x, item_1_y, config::ARMOUR_PICKUP_PATH));
 				break;
 			case config::item_codes::AMMO:
-				game_entities_.push_back(std::make_shared<entities::ammo_pickup>(item_1_x, item_1_y, config::AMMO_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::ammo_pickup>(item_1_x, item_1_y, config::AMMO_PICKUP_PATH));
 				break;
 			case config::item_codes::RIFLE:
-				game_entities_.push_back(std::make_shared<entities::rifle_pickup>(item_1_x, item_1_y, config::RIFLE_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::rifle_pickup>(item_1_x, item_1_y, config::RIFLE_PICKUP_PATH));
 				break;
 			case config::item_codes::STRAWMAN:
-				game_entities_.push_back(std::make_shared<entities::strawman_pickup>(item_1_x, item_1_y, config::STRAWMAN_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::strawman_pickup>(item_1_x, item_1_y, config::STRAWMAN_PICKUP_PATH));
+				break;
+			case config::item_codes::DYNAMITE:
+				game_entities_.push_back(memory::make_round<entities::dynamite_pickup>(item_1_x, item_1_y, config::DYNAMITE_PICKUP_PATH));
 				break;
 		}
 		// spawn an item for p2
 		switch (item_2_type) {
 			case config::item_codes::HEALTH:
-				game_entities_.push_back(std::make_shared<entities::health_pickup>(item_2_x, item_2_y, config::HEALTH_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::health_pickup>(item_2_x, item_2_y, config::HEALTH_PICKUP_PATH));
 				break;
 			case config::item_codes::ARMOUR:
-				game_entities_.push_back(std::make_shared<entities::armour_pickup>(item_2_x, item_2_y, config::ARMOUR_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::armour_pickup>(item_2_x, item_2_y, config::ARMOUR_PICKUP_PATH));
 				break;
 			case config::item_codes::AMMO:
-				game_entities_.push_back(std::make_shared<entities::ammo_pickup>(item_2_x, item_2_y, config::AMMO_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::ammo_pickup>(item_2_x, item_2_y, config::AMMO_PICKUP_PATH));
 				break;
 			case config::item_codes::RIFLE:
-				game_entities_.push_back(std::make_shared<entities::rifle_pickup>(item_2_x, item_2_y, config::RIFLE_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::rifle_pickup>(item_2_x, item_2_y, config::RIFLE_PICKUP_PATH));
 				break;
 			case config::item_codes::STRAWMAN:
-				game_entities_.push_back(std::make_shared<entities::strawman_pickup>(item_2_x, item_2_y, config::STRAWMAN_PICKUP_PATH));
+				game_entities_.push_back(memory::make_round<entities::strawman_pickup>(item_2_x, item_2_y, config::STRAWMAN_PICKUP_PATH));
+				break;
+			case config::item_codes::DYNAMITE:
+				game_entities_.push_back(memory::make_round<entities::dynamite_pickup>(item_2_x, item_2_y, config::DYNAMITE_PICKUP_PATH));
 				break;
 		}
 	}
@@ -11,7 +11,22 @@
 #include "entities.h"
 #include "level_builder.h"
 #include "player.h"
+#include "hud.h"
+#include "render_queue.h"
+#include "input.h"
+#include "arena.h"
+#include "events.h"
+#include "spectator.h"
+#include "spatial.h"
+#include "collision.h"
+#include "deferred.h"
+#include "particles.h"
+#include "killcam.h"
+#include "snapshot.h"
+#include "triple_buffer.h"
+#include <array>
 #include <map>
+#include <random>
 #include <utility>
 class game_manager{
 public:
@@ -23,31 +38,57 @@ public:
 		scores_ = animation(config::SCORE_PATH, config::SCORE_WIDTH, config::SCORE_HEIGHT, config::SCORES_LENGTH, config::SCORES_ANIMATIONS);
 		header_ = animation(config::HUD_HEAD_PATH, config::SCREEN_WIDTH, config::PLAYABLE_Y);
 		footer_ = animation(config::HUD_FOOT_PATH, config::SCREEN_WIDTH, config::PLAYABLE_Y + config::HUD_HEIGHT);
-		
-		for (auto& path : config::VOICE_LINES) {
-			voicelines_.push_back(LoadSound(path));
-		}
+		header_panel_ = hud_panel(0.0, 0.0, config::SCREEN_WIDTH, config::PLAYABLE_Y);
 	};
 
 
 	/**  manage entities in the game */
+	void add_entity(std::shared_ptr<entities::entity> entity);
 	void remove_entities();
 	void clear_entities();
 	void build_level();
+	void pregenerate_level();
 	void spawn_items();
 
 	/**  update game entities */
 	void update_entities();
+	void animate_entities(float dt);
 
-	/**  draw the game  */
+	/**  draw the game, the simulation records each frame and the renderer draws the latest one.
+	 * draw_game does both, for scenes where they share a thread */
 	void draw_game();
+	void record_frame();
+	void draw_frame();
 	void draw_background();
-	void draw_entities();
-	void draw_scores();
+	void draw_entities(render::render_queue& queue);
+	void draw_effects(const render::snapshot& frame); // particles are moved by the drawn frame's time, so they settle during the post round
+	void draw_scores(std::pair<int, int> scores);
 	void update_players();
-	void draw_players();
+	void update_player(std::uint8_t id); // one player alone, deaths are left to the caller
+	void draw_players(render::render_queue& queue);
+	void draw_game_over();
+	void present_events(); // the dead pose, part of the simulation's state
+
+	/**  kill cam, the round is recorded every tick once enabled and replayed after a kill */
+	void enable_killcam();
+	void record_killcam();
+	double get_killcam_length() const; // 0 unless the round ended in a kill
+	void draw_killcam(double elapsed);
+
+	/**  spectators, the world is broadcast every tick once enabled */
+	void enable_spectators(std::uint16_t port);
+	void broadcast_state();
+	spectator::match_state get_match_state();
 
 	/**  accessors  */
+	render::render_stats get_render_stats() const;
+	input::input_queue& get_input();
+	memory::round_arena& get_arena(); // the arena of the round being played
+	events::subscriber& get_audio_events();
+	std::size_t get_entity_count() const;
+	std::size_t get_drawn_entity_count() const; // in the frame drawn last, safe while the simulation runs
+	const std::vector<std::shared_ptr<entities::entity>>& get_entities() const;
+	player& get_player(std::uint8_t id); // 1 or 2, as published in events
 	int get_round_num();
 	int get_frame_count();
 
@@ -56,35 +97,80 @@ public:
 	void increment_frame_count();
 	void reset_level();
 	void reset_scores();
+	void seed(unsigned int seed); // repeat the same levels and items
 
 	/**  round transitions and win conditions */
+	void restart(unsigned int seed); // build the first round again, the same seed always gives the same game
 	void end_round();
+	void revive_players(); // reset the players without changing the level
 	bool is_round_over();
-	void pre_round();
-	void post_round();
+	void draw_round_intro();
 	bool game_over();
 	void draw_win();
 	void play_voiceline();
 private:
+	/**  round scoped entities are built in the arena of their round, the other
+	 * arena holds the pregenerated level. They swap when the level is built.
+	 * Declared first so they outlive everything that points into them */
+	std::array<memory::round_arena, 2> arenas_;
+	int current_arena_ = 0;
+
+	/**  gameplay events, published during the update and consumed by the audio, by
+	 * present_events after the update and by the particles as each frame is drawn */
+	events::bus bus_;
+	events::subscriber& audio_events_ = bus_.subscribe();
+	events::subscriber& presentation_events_ = bus_.subscribe();
+	events::subscriber& effect_events_ = bus_.subscribe();
+
+	/**  cosmetic particles, emitted from the presented events and never seen by the simulation */
+	particles::pool particles_;
+	float dust_due_ = 0.0f; // dust owed to each tumbleweed, carried between frames
+
 	/**  the two players and entities*/
 	player player_1_;
 	player player_2_;
-	std::vector<std::shared_ptr<entities::entity>> game_entities_;
+	std::vector<std::shared_ptr<entities::entity>> game_entities_; // one run per batched archetype then the rest, see update_entities
+	std::size_t partitioned_ = 0; // the entities at the front already in their runs, the ones pushed since follow
+	spatial::grid grid_; // the entities binned for explosions, rebuilt by the first one each update
+	collision::rect_batch collision_batch_; // the entities' rectangles, packed as each update starts
+	std::vector<deferred::buffer> deferred_; // what each range of the entities' update did to the others
 
 	/**  game info */
 	int frame_count_ = 0;
-	double last_spawn_time = 0.0;
+	double last_spawn_time = -config::ITEM_SPAWN_DELAY; // simulated seconds, an item spawns as the round starts
+	std::mt19937 random_{ std::random_device{}() }; // this game's random numbers, bound while it generates
 	int round_num_ = 1;
 	bool round_over_ = false;
 
+	/**  obstacles for the next round, generated during the post round */
+	std::unique_ptr<level::level_builder> next_level_;
+
+	/**  gameplay key presses, sampled between frames */
+	input::input_queue input_;
+
+	/**  nullptr unless the kill cam is enabled */
+	std::unique_ptr<killcam::recorder> killcam_;
+	std::array<Vector2, 2> last_hits_{}; // where each gunman was last hit, the kill cam looks for what hit them there
+
+	/**  nullptr unless spectators are enabled */
+	std::unique_ptr<spectator::broadcaster> spectators_;
+
+	/**  frames recorded by the simulation for the renderer */
+	render::triple_buffer<render::snapshot> frames_;
+	std::size_t drawn_entities_ = 0;
+
+	/**  sprites are queued while drawing and flushed once per frame */
+	render::render_queue render_queue_;
+
 	/**  animations for drawing */
 	animation scores_;
 	animation background_;
 	animation header_;
 	animation footer_;
 
-	/**  voice lines */
-	std::vector<Sound> voicelines_;
+	/**  header and scores, re-rendered only when a score changes */
+	hud_panel header_panel_;
+	std::pair<int, int> drawn_scores_ = { -1, -1 };
 };
 
 
@@ -6,6 +6,8 @@
  * \date   February 2025
  *********************************************************************/
 #include "entities.h"
+#include "profiler.h"
+#include "collision.h"
 
 
 bool entities::gunman::operator==(const entities::entity& other) {
@@ -51,7 +53,7 @@ bool entities::gunman::collide(entities::entity& other) {
 /**  returns boolean based on whether the gunman can move or not */
 bool entities::gunman::move(Vector2& movement_vector, std::vector<std::shared_ptr<entities::entity>>& entities) {
 
-	animation_.next_frame_loop();
+	moving_ = true;
 	Vector2 new_pos = { position_.x + movement_vector.x, position_.y + movement_vector.y };
 	/**  new proposed position  */
 	Rectangle proposed_rect = get_rectangle();
@@ -59,16 +61,15 @@ bool entities::gunman::move(Vector2& movement_vector, std::vector<std::shared_pt
 	proposed_rect.y = new_pos.y;
 
 	/**  check if  gunman movement is blocked by an obstacle */
+	PROFILE_ZONE("collisions");
 	bool blocked = false;
-	std::for_each(entities.begin(), entities.end(), [this, &blocked, &proposed_rect](std::shared_ptr<entities::entity>& e)
-		{
-			if (this != e.get() and CheckCollisionRecs(proposed_rect, e->get_rectangle())) {
-				// if collide is false then do not move
-				if (not this->collide(*e)) {
-					blocked = true;
-				}
-			}
-		});
+	collision::for_each_overlap(entities, proposed_rect, [this, &blocked](entities::entity& e) {
+		// if collide is false then do not move
+		if (this != &e and not collide(e)) {
+			blocked = true;
+		}
+		return true;
+	});
 
 	if (blocked) {
 		return false;
@@ -81,6 +82,13 @@ bool entities::gunman::move(Vector2& movement_vector, std::vector<std::shared_pt
 	}
 	return false;
 }
+/**  the walk cycle advances once per frame of movement, no matter how many keys are held */
+void entities::gunman::animate(float dt) {
+	if (moving_) {
+		animation_.advance(dt);
+	}
+	moving_ = false;
+}
 void entities::gunman::take_damage(int damage) {
 	/**  if the player has armour it absorbs the entirety of the damage */
 	if (armour_ > 0) {
@@ -103,10 +111,10 @@ void entities::gunman::reset(float x, float y) {
 	health_ = config::GUNMAN_HEALTH;
 	armour_ = 0;
 	if (direction_ == 1) {
-		animation_ = animation(config::P1_PATH, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS);
+		animation_ = animation(config::P1_PATH, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS, config::GUNMAN_FRAME_TIME);
 	}
 	else {
-		animation_ = animation(config::P2_PATH, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS);	
+		animation_ = animation(config::P2_PATH, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS, config::GUNMAN_FRAME_TIME);
 	}
 }
 
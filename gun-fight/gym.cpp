@@ -0,0 +1,261 @@
+/*****************************************************************//**
+ * \file   gym.cpp
+ * \brief  implementation file for the training environments
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "gym.h"
+#include "resources.h"
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <string_view>
+
+namespace {
+	/**  the pickups' sheets in config::item_codes order, a held or dropped item is told apart by its sheet */
+	const std::array<std::string_view, gym::ITEM_KINDS> ITEM_PATHS = {
+		config::HEALTH_PICKUP_PATH, config::ARMOUR_PICKUP_PATH, config::AMMO_PICKUP_PATH,
+		config::RIFLE_PICKUP_PATH, config::STRAWMAN_PICKUP_PATH, config::DYNAMITE_PICKUP_PATH
+	};
+
+	/**  -1 for the empty item */
+	int item_kind(const char* path) {
+		if (path == nullptr) { return -1; }
+		auto it = std::find(ITEM_PATHS.begin(), ITEM_PATHS.end(), std::string_view(path));
+		return it == ITEM_PATHS.end() ? -1 : static_cast<int>(it - ITEM_PATHS.begin());
+	}
+
+	float scale_x(float x, bool mirrored) {
+		auto scaled = std::clamp((x - config::PLAYABLE_X) / config::PLAYABLE_WIDTH, 0.0f, 1.0f);
+		return mirrored ? 1.0f - scaled : scaled;
+	}
+
+	float scale_y(float y) {
+		return std::clamp((y - config::PLAYABLE_Y) / config::PLAYABLE_HEIGHT, 0.0f, 1.0f);
+	}
+
+	Vector2 centre_of(entities::entity& e) {
+		auto r = e.get_rectangle();
+		return Vector2{ r.x + r.width / 2, r.y + r.height / 2 };
+	}
+
+	int vitality_of(player& p) {
+		auto gunman = p.get_gunman();
+		return gunman->get_health() + gunman->get_armour();
+	}
+}
+
+/**  environment */
+gym::environment::environment()
+	: manager_(player::create(1), player::create(2)) {
+	manager_.get_input().set_keyboard(false);
+}
+
+void gym::environment::reset(unsigned int seed, float* observations){
+	manager_.restart(seed);
+	begin_episode();
+	observe(observations);
+}
+
+/**  the playing scene's tick, with nothing drawn or heard */
+bool gym::environment::step(const action* actions, float* observations, float* rewards){
+	auto& input = manager_.get_input();
+	for (std::size_t a = 0; a < AGENTS; ++a) {
+		server::apply_input(input, static_cast<int>(a), actions[a]);
+	}
+	input.begin_frame();
+	manager_.update_players();
+	manager_.spawn_items();
+	manager_.update_entities();
+	manager_.remove_entities();
+	manager_.animate_entities(1.0f / config::TARGET_FPS);
+	manager_.increment_frame_count();
+	manager_.get_audio_events().drain([](auto&) {});
+	manager_.present_events();
+	++ticks_;
+
+	/**  what each gunman lost this tick is the other's gain, pickups taken are not counted against anyone */
+	auto lost = std::array<float, AGENTS>{};
+	for (std::size_t a = 0; a < AGENTS; ++a) {
+		auto vitality = vitality_of(manager_.get_player(static_cast<std::uint8_t>(a + 1)));
+		lost[a] = static_cast<float>(std::max(0, vitality_[a] - vitality));
+		vitality_[a] = vitality;
+	}
+	rewards[0] = config::GYM_HIT_REWARD * (lost[1] - lost[0]);
+	rewards[1] = config::GYM_HIT_REWARD * (lost[0] - lost[1]);
+
+	auto done = manager_.is_round_over() or ticks_ >= config::GYM_MAX_TICKS;
+	if (manager_.is_round_over()) {
+		auto winner = manager_.get_player(1).is_dead() ? 1 : 0;
+		rewards[winner] += config::GYM_WIN_REWARD;
+		rewards[1 - winner] -= config::GYM_WIN_REWARD;
+	}
+	if (done) {
+		/**  a round cut short is ended here too, so the next one spawns items from its start */
+		manager_.end_round();
+		/**  the scores are never observed, a finished game goes straight on like the server's */
+		if (manager_.game_over()) {
+			manager_.reset_scores();
+		}
+		manager_.build_level();
+		input.clear();
+		begin_episode();
+	}
+	observe(observations);
+	return done;
+}
+
+void gym::environment::begin_episode(){
+	ticks_ = 0;
+	for (std::size_t a = 0; a < AGENTS; ++a) {
+		vitality_[a] = vitality_of(manager_.get_player(static_cast<std::uint8_t>(a + 1)));
+	}
+}
+
+/**  the entities are sorted into the observation in one pass, the grid is shared by both agents */
+void gym::environment::observe(float* observations){
+	auto second = observations + OBSERVATION_SIZE;
+	std::fill(observations, observations + AGENTS * OBSERVATION_SIZE, 0.0f);
+	observe_gunman(1, false, observations);
+	observe_gunman(2, false, observations + GUNMAN_FEATURES);
+	observe_gunman(2, true, second);
+	observe_gunman(1, true, second + GUNMAN_FEATURES);
+
+	grid_.fill(0.0f);
+	auto projectiles = std::size_t{ 0 };
+	auto pickups = std::size_t{ 0 };
+	auto projectile_offset = AGENTS * GUNMAN_FEATURES;
+	auto pickup_offset = projectile_offset + config::GYM_MAX_PROJECTILES * PROJECTILE_FEATURES;
+	auto cell_width = static_cast<float>(config::PLAYABLE_WIDTH) / config::GYM_GRID_COLUMNS;
+	auto cell_height = static_cast<float>(config::PLAYABLE_HEIGHT) / config::GYM_GRID_ROWS;
+	for (auto& e : manager_.get_entities()) {
+		if (auto projectile = dynamic_cast<entities::projectile*>(e.get())) {
+			if (projectiles == config::GYM_MAX_PROJECTILES) { continue; }
+			auto centre = centre_of(*projectile);
+			auto heading = projectile->get_speed_direction().y;
+			auto dynamite = projectile->get_archetype() == &archetype::DYNAMITE_STICK ? 1.0f : 0.0f;
+			auto out = observations + projectile_offset + projectiles * PROJECTILE_FEATURES;
+			out[0] = scale_x(centre.x, false);
+			out[1] = scale_y(centre.y);
+			out[2] = heading;
+			out[3] = dynamite;
+			out = second + projectile_offset + projectiles * PROJECTILE_FEATURES;
+			out[0] = scale_x(centre.x, true);
+			out[1] = scale_y(centre.y);
+			out[2] = -heading;
+			out[3] = dynamite;
+			++projectiles;
+		}
+		else if (auto pickup = dynamic_cast<entities::pickup*>(e.get())) {
+			auto kind = item_kind(pickup->get_path());
+			if (pickups == config::GYM_MAX_PICKUPS or kind < 0 or pickup->get_state() != entities::pickup::pickup_state::ON_GROUND) { continue; }
+			auto centre = centre_of(*pickup);
+			auto out = observations + pickup_offset + pickups * PICKUP_FEATURES;
+			out[0] = scale_x(centre.x, false);
+			out[1] = scale_y(centre.y);
+			out[2 + kind] = 1.0f;
+			out = second + pickup_offset + pickups * PICKUP_FEATURES;
+			out[0] = scale_x(centre.x, true);
+			out[1] = scale_y(centre.y);
+			out[2 + kind] = 1.0f;
+			++pickups;
+		}
+		else if (dynamic_cast<entities::obstacle*>(e.get()) != nullptr) {
+			auto r = e->get_rectangle();
+			auto cell = [](float position, float size, std::size_t cells) {
+				return static_cast<std::size_t>(std::clamp(position / size, 0.0f, static_cast<float>(cells - 1)));
+			};
+			auto left = cell(r.x - config::PLAYABLE_X, cell_width, config::GYM_GRID_COLUMNS);
+			auto right = cell(r.x + r.width - config::PLAYABLE_X, cell_width, config::GYM_GRID_COLUMNS);
+			auto top = cell(r.y - config::PLAYABLE_Y, cell_height, config::GYM_GRID_ROWS);
+			auto bottom = cell(r.y + r.height - config::PLAYABLE_Y, cell_height, config::GYM_GRID_ROWS);
+			for (auto row = top; row <= bottom; ++row) {
+				std::fill(grid_.begin() + row * config::GYM_GRID_COLUMNS + left, grid_.begin() + row * config::GYM_GRID_COLUMNS + right + 1, 1.0f);
+			}
+		}
+	}
+
+	auto grid_offset = pickup_offset + config::GYM_MAX_PICKUPS * PICKUP_FEATURES;
+	std::copy(grid_.begin(), grid_.end(), observations + grid_offset);
+	for (std::size_t row = 0; row < config::GYM_GRID_ROWS; ++row) {
+		auto from = grid_.begin() + row * config::GYM_GRID_COLUMNS;
+		std::reverse_copy(from, from + config::GYM_GRID_COLUMNS, second + grid_offset + row * config::GYM_GRID_COLUMNS);
+	}
+	auto time = static_cast<float>(ticks_) / config::GYM_MAX_TICKS;
+	observations[OBSERVATION_SIZE - 1] = time;
+	second[OBSERVATION_SIZE - 1] = time;
+}
+
+/**  the out slot is already zeroed */
+void gym::environment::observe_gunman(std::uint8_t id, bool mirrored, float* out){
+	auto& p = manager_.get_player(id);
+	auto gunman = p.get_gunman();
+	auto weapon = p.get_weapon();
+	auto centre = centre_of(*gunman);
+	out[0] = scale_x(centre.x, mirrored);
+	out[1] = scale_y(centre.y);
+	out[2] = static_cast<float>(gunman->get_health()) / config::GUNMAN_HEALTH;
+	out[3] = static_cast<float>(gunman->get_armour());
+	out[4] = static_cast<float>(weapon->get_ammo());
+	out[5] = weapon->is_empty() ? 1.0f : 0.0f;
+	auto weapon_kind = dynamic_cast<entities::dynamite*>(weapon.get()) != nullptr ? 2
+		: dynamic_cast<entities::rifle*>(weapon.get()) != nullptr ? 1 : 0;
+	out[6 + weapon_kind] = 1.0f;
+	if (auto kind = item_kind(p.get_item()->get_path()); kind >= 0) {
+		out[6 + WEAPON_KINDS + kind] = 1.0f;
+	}
+}
+
+/**  vector_env */
+gym::vector_env::vector_env(std::size_t count, unsigned int threads)
+	: pool_(threads) {
+	resources::set_headless(true);
+	for (std::size_t i = 0; i < count; ++i) {
+		environments_.push_back(std::make_unique<environment>());
+	}
+}
+
+void gym::vector_env::reset(unsigned int seed, float* observations){
+	for_each_environment([&](std::size_t e) {
+		environments_[e]->reset(seed + static_cast<unsigned int>(e), observations + e * AGENTS * OBSERVATION_SIZE);
+		});
+}
+
+void gym::vector_env::step(const action* actions, float* observations, float* rewards, std::uint8_t* dones){
+	for_each_environment([&](std::size_t e) {
+		auto done = environments_[e]->step(actions + e * AGENTS, observations + e * AGENTS * OBSERVATION_SIZE, rewards + e * AGENTS);
+		dones[e] = done ? 1 : 0;
+		});
+}
+
+std::size_t gym::vector_env::size() const {
+	return environments_.size();
+}
+
+/**  each environment's loops run on the thread stepping it, the environments are what is shared out.
+ * An exception on a worker would end the process, so the first one thrown is carried back here */
+template<typename environment_fn>
+void gym::vector_env::for_each_environment(environment_fn run){
+	auto failure = std::exception_ptr{};
+	auto failure_mutex = std::mutex{};
+	auto body = [&](std::size_t begin, std::size_t end) {
+		auto inline_loops = jobs::inline_scope();
+		try {
+			for (auto e = begin; e < end; ++e) {
+				run(e);
+			}
+		}
+		catch (...) {
+			auto lock = std::lock_guard(failure_mutex);
+			if (failure == nullptr) {
+				failure = std::current_exception();
+			}
+		}
+	};
+	auto shared = jobs::pool_scope(pool_);
+	jobs::parallel_for(environments_.size(), config::GYM_ENV_GRAIN, body);
+	if (failure != nullptr) {
+		std::rethrow_exception(failure);
+	}
+}
@@ -0,0 +1,100 @@
+/*****************************************************************//**
+ * \file   gym.h
+ * \brief  header file for the training environments, the simulation as a
+ * reset and step api for bots learning offline. An environment is one
+ * headless game_manager played by two agents, a step is one tick at the
+ * target frame rate with the agents' controls, in the server's input format.
+ *
+ * Each agent observes the game from its own side: itself first, then the
+ * other gunman, and the arena mirrored for player 2 so both see their
+ * opponent to the right. Positions are the centre of a sprite scaled into
+ * [0, 1] over the playable area. One observation is OBSERVATION_SIZE floats:
+ *
+ *   gunman x 2       x, y, health, armour, ammo, empty, weapon one-hot (3), held item one-hot (6)
+ *   projectile x 16  x, y, heading (1 towards the other gunman), dynamite, zeros past the last
+ *   pickup x 4       x, y, item one-hot (6), zeros past the last
+ *   grid 32 x 16     1 where an obstacle covers the cell, row by row from the top left
+ *   time             the share of config::GYM_MAX_TICKS the round has run for
+ *
+ * An episode is one round. A step that ends it, by a kill or by running
+ * config::GYM_MAX_TICKS, reports done and builds the next round, so the
+ * observation it writes is the first of the next episode.
+ *
+ * A vector of environments is stepped in lockstep, shared across a job pool
+ * with each environment's own loops run inline. Actions, observations,
+ * rewards and dones are read from and written into caller owned arrays,
+ * environment by environment and agent by agent, so nothing is copied
+ * between steps
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "game_manager.h"
+#include "server.h"
+#include "jobs.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gym {
+	inline constexpr std::size_t AGENTS = 2;
+	inline constexpr std::size_t WEAPON_KINDS = 3; // revolver, rifle, dynamite
+	inline constexpr std::size_t ITEM_KINDS = 6; // config::item_codes
+	inline constexpr std::size_t GUNMAN_FEATURES = 6 + WEAPON_KINDS + ITEM_KINDS;
+	inline constexpr std::size_t PROJECTILE_FEATURES = 4;
+	inline constexpr std::size_t PICKUP_FEATURES = 2 + ITEM_KINDS;
+	inline constexpr std::size_t GRID_CELLS = config::GYM_GRID_COLUMNS * config::GYM_GRID_ROWS;
+	inline constexpr std::size_t OBSERVATION_SIZE = AGENTS * GUNMAN_FEATURES + config::GYM_MAX_PROJECTILES * PROJECTILE_FEATURES
+		+ config::GYM_MAX_PICKUPS * PICKUP_FEATURES + GRID_CELLS + 1;
+
+	using action = server::input_message;
+
+	/**  one game, needs headless mode set before it is made */
+	class environment {
+	public:
+		/**  constructors and destructors */
+		~environment() = default;
+		environment();
+		environment(const environment&) = delete;
+		environment& operator=(const environment&) = delete;
+
+		/**  start over from the first round, writes AGENTS observations */
+		void reset(unsigned int seed, float* observations);
+		/**  one tick with an action per agent, writes AGENTS observations and rewards. True if the round ended */
+		bool step(const action* actions, float* observations, float* rewards);
+	private:
+		void begin_episode();
+		void observe(float* observations);
+		void observe_gunman(std::uint8_t id, bool mirrored, float* out);
+
+		game_manager manager_;
+		int ticks_ = 0;
+		std::array<int, AGENTS> vitality_{}; // each gunman's health and armour after the last step
+		std::array<float, GRID_CELLS> grid_{}; // as player 1 sees it, player 2's is read mirrored
+	};
+
+	/**  environments stepped together, agent a of environment e is index e * AGENTS + a in every array */
+	class vector_env {
+	public:
+		/**  constructors and destructors, sets headless mode. The default pool leaves a core for the calling thread */
+		~vector_env() = default;
+		explicit vector_env(std::size_t count, unsigned int threads = std::max(1u, std::thread::hardware_concurrency()) - 1);
+		vector_env(const vector_env&) = delete;
+		vector_env& operator=(const vector_env&) = delete;
+
+		/**  environment e is reset with seed + e */
+		void reset(unsigned int seed, float* observations);
+		void step(const action* actions, float* observations, float* rewards, std::uint8_t* dones);
+		std::size_t size() const;
+	private:
+		/**  run(e) for every environment e, rethrows the first exception on the calling thread */
+		template<typename environment_fn>
+		void for_each_environment(environment_fn run);
+
+		std::vector<std::unique_ptr<environment>> environments_;
+		jobs::pool pool_;
+	};
+}
@@ -0,0 +1,65 @@
+/*****************************************************************//**
+ * \file   hud.cpp
+ * \brief  implementation file for cached hud panels
+ * 
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "hud.h"
+#include <utility>
+
+/**  panels outliving the window went with its context */
+hud_panel::~hud_panel(){
+	if (target_.id != 0 and IsWindowReady()) {
+		UnloadRenderTexture(target_);
+	}
+}
+
+hud_panel& hud_panel::operator=(const hud_panel& other){
+	if (this != &other) {
+		*this = hud_panel(other);
+	}
+	return *this;
+}
+
+/**  the target this panel had is unloaded by other as it goes */
+hud_panel& hud_panel::operator=(hud_panel&& other) noexcept {
+	std::swap(position_, other.position_);
+	std::swap(width_, other.width_);
+	std::swap(height_, other.height_);
+	std::swap(target_, other.target_);
+	std::swap(rendered_, other.rendered_);
+	return *this;
+}
+
+bool hud_panel::is_rendered(){
+	return rendered_;
+}
+
+Vector2 hud_panel::get_position(){
+	return position_;
+}
+
+void hud_panel::begin_render(){
+	if (target_.id == 0) {
+		target_ = LoadRenderTexture(width_, height_);
+	}
+	BeginTextureMode(target_);
+	ClearBackground(BLANK);
+}
+
+void hud_panel::end_render(){
+	EndTextureMode();
+	rendered_ = true;
+}
+
+void hud_panel::draw(render::render_queue& queue){
+	if (not rendered_) { return; }
+	/**  render textures are stored upside down, flip the source rectangle */
+	auto source = Rectangle{ 0.0, 0.0, static_cast<float>(width_), -static_cast<float>(height_) };
+	queue.submit(render::HUD, position_.y, target_.texture, source, position_);
+}
+
+void hud_panel::invalidate(){
+	rendered_ = false;
+}
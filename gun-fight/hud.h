@@ -0,0 +1,66 @@
+/*****************************************************************//**
+ * \file   hud.h
+ * \brief  header file for cached hud panels. A panel is rendered into an
+ * offscreen target and only re-rendered when the values it shows change,
+ * otherwise the cached panel is drawn as a single texture
+ * 
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "render_queue.h"
+
+/**  the values displayed on a player's hud panel, compared each frame to decide if the panel is stale */
+struct hud_state {
+	int health = 0;
+	int armour = 0;
+	int ammo = 0;
+	bool empty = false;
+	unsigned int weapon_sheet = 0; // identifies the weapon type
+	float weapon_frame_x = 0.0;
+	float weapon_frame_y = 0.0;
+	const char* item_path = nullptr;
+	bool operator==(const hud_state& other) const = default;
+};
+
+/**  an offscreen render target positioned on the screen */
+class hud_panel {
+public:
+	/**  constructors and destructors. Each panel owns its target, a copy gets its own and renders into it
+	 * on first use, a move takes the other's */
+	~hud_panel();
+	hud_panel() = default;
+	hud_panel(float x, float y, int width, int height)
+		: position_({ x, y }), width_(width), height_(height) {
+	};
+	hud_panel(const hud_panel& other)
+		: position_(other.position_), width_(other.width_), height_(other.height_) {
+	};
+	hud_panel(hud_panel&& other) noexcept
+		: position_(other.position_), width_(other.width_), height_(other.height_), target_(other.target_), rendered_(other.rendered_) {
+		other.target_ = {};
+		other.rendered_ = false;
+	};
+	hud_panel& operator=(const hud_panel& other);
+	hud_panel& operator=(hud_panel&& other) noexcept;
+
+	/**  accessors */
+	bool is_rendered();
+	Vector2 get_position();
+
+	/**  redirect drawing into the panel, coordinates are relative to the panel origin */
+	void begin_render();
+	void end_render();
+
+	/**  queue the cached panel for drawing */
+	void draw(render::render_queue& queue);
+	/**  force the panel to be re-rendered on the next frame */
+	void invalidate();
+private:
+	Vector2 position_ = { 0.0, 0.0 };
+	int width_ = 0;
+	int height_ = 0;
+	RenderTexture2D target_ = {}; // created on first render, requires the window to exist
+	bool rendered_ = false;
+};
@@ -0,0 +1,137 @@
+/*****************************************************************//**
+ * \file   input.cpp
+ * \brief  implementation file for the gameplay input queue
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "input.h"
+#include "config.h"
+#include <algorithm>
+
+double input::latency_stats::mean() const {
+	return samples > 0 ? total / samples : 0.0;
+}
+
+/**  raylib queues every key pressed since the last poll, so short taps are not missed. The
+ * held keys are copied too, the simulation's thread must not read raylib's key state */
+void input::input_queue::sample(){
+	if (not keyboard_) { return; }
+	auto now = GetTime();
+	auto lock = std::lock_guard(mutex_);
+	for (auto key = GetKeyPressed(); key != 0; key = GetKeyPressed()) {
+		pending_.push_back(key_event{ key, now });
+	}
+	for (auto key = 0; key < KEY_COUNT; ++key) {
+		down_[key] = IsKeyDown(key);
+	}
+}
+
+/**  sleep in short slices, polling between them, so presses are stamped to within a slice */
+void input::input_queue::pace(double frame_end){
+	sample();
+	while (GetTime() + config::INPUT_POLL_INTERVAL < frame_end) {
+		WaitTime(config::INPUT_POLL_INTERVAL);
+		PollInputEvents();
+		sample();
+	}
+	auto remaining = frame_end - GetTime();
+	if (remaining > 0.0) {
+		WaitTime(remaining);
+	}
+}
+
+void input::input_queue::push(int key){
+	auto lock = std::lock_guard(mutex_);
+	pending_.push_back(key_event{ key, GetTime() });
+}
+
+void input::input_queue::hold(int key, bool down){
+	auto it = std::find(held_.begin(), held_.end(), key);
+	if (down and it == held_.end()) {
+		held_.push_back(key);
+	}
+	else if (not down and it != held_.end()) {
+		held_.erase(it);
+	}
+}
+
+void input::input_queue::set_keyboard(bool enabled){
+	keyboard_ = enabled;
+}
+
+void input::input_queue::set_concurrent(bool concurrent){
+	concurrent_ = concurrent;
+}
+
+void input::input_queue::begin_frame(){
+	if (not concurrent_) {
+		sample();
+	}
+	auto lock = std::lock_guard(mutex_);
+	frame_time_ = GetTime();
+	frame_.swap(pending_);
+	pending_.clear();
+	frame_down_ = down_;
+}
+
+/**  the presses are only counted as shown by a swap after the frame that simulated them was recorded */
+void input::input_queue::end_frame(){
+	auto lock = std::lock_guard(mutex_);
+	for (auto& e : frame_) {
+		undisplayed_.push_back(e.time);
+	}
+}
+
+void input::input_queue::presented(){
+	auto now = GetTime();
+	auto lock = std::lock_guard(mutex_);
+	for (auto time : undisplayed_) {
+		auto latency = now - time;
+		++latency_.samples;
+		latency_.total += latency;
+		latency_.max = std::max(latency_.max, latency);
+	}
+	undisplayed_.clear();
+}
+
+void input::input_queue::clear(){
+	auto lock = std::lock_guard(mutex_);
+	pending_.clear();
+	down_.reset();
+	undisplayed_.clear();
+	frame_.clear();
+	frame_down_.reset();
+	held_.clear();
+}
+
+bool input::input_queue::pressed(int key) const {
+	return std::any_of(frame_.begin(), frame_.end(), [key](auto& e) { return e.key == key; });
+}
+
+bool input::input_queue::held(int key) const {
+	if (keyboard_ and key >= 0 and key < KEY_COUNT and frame_down_[key]) { return true; }
+	return std::find(held_.begin(), held_.end(), key) != held_.end();
+}
+
+double input::input_queue::press_time(int key) const {
+	auto it = std::find_if(frame_.begin(), frame_.end(), [key](auto& e) { return e.key == key; });
+	return it != frame_.end() ? it->time : frame_time_;
+}
+
+double input::input_queue::get_frame_time() const {
+	return frame_time_;
+}
+
+float input::input_queue::get_lead(int key) const {
+	auto lead = (frame_time_ - press_time(key)) * config::TARGET_FPS;
+	return std::clamp(static_cast<float>(lead), 0.0f, 1.0f);
+}
+
+const input::latency_stats& input::input_queue::get_latency() const {
+	return latency_;
+}
+
+void input::input_queue::reset_latency(){
+	latency_ = latency_stats{};
+}
@@ -0,0 +1,93 @@
+/*****************************************************************//**
+ * \file   input.h
+ * \brief  header file for the gameplay input queue. Key presses are sampled
+ * from the os throughout the frame, including the time that would otherwise
+ * be spent sleeping, and stamped with the time they were seen. The simulation
+ * consumes them just before it runs, so same-frame presses can be ordered and
+ * the time from a press to the frame that shows it can be measured.
+ *
+ * During a round the simulation runs on its own thread. The keyboard is only
+ * ever read on the window's thread, which samples the presses and the keys
+ * held down, and the simulation takes a copy of both as each tick starts
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include <bitset>
+#include <mutex>
+#include <vector>
+
+namespace input {
+	/**  a key press and the time it was seen */
+	struct key_event {
+		int key;
+		double time;
+	};
+
+	/**  raylib's MAX_KEYBOARD_KEYS, every key code is below it */
+	inline constexpr int KEY_COUNT = 512;
+
+	/**  time from a key press to the buffer swap of the first frame simulated with it */
+	struct latency_stats {
+		int samples = 0;
+		double total = 0.0;
+		double max = 0.0;
+		double mean() const;
+	};
+
+	class input_queue {
+	public:
+		/**  constructors and destructors */
+		~input_queue() = default;
+		input_queue() = default;
+
+		/**  sampling, called between frames */
+		void sample(); // record presses and held keys from the last os poll
+		void pace(double frame_end); // keep polling until the end of the frame instead of sleeping
+
+		/**  queue a press that did not come from the keyboard, used by bots */
+		void push(int key);
+		/**  hold or release a key that does not come from the keyboard */
+		void hold(int key, bool down);
+		/**  false stops the keyboard being read at all, for games driven over the network */
+		void set_keyboard(bool enabled);
+		/**  true while the simulation runs on another thread, it then leaves sampling to the window's */
+		void set_concurrent(bool concurrent);
+
+		/**  hands the presses sampled so far to the simulation */
+		void begin_frame();
+		/**  the frame simulated with them has been recorded for drawing */
+		void end_frame();
+		/**  the frame has been swapped to the screen */
+		void presented();
+		void clear();
+
+		/**  queries for the simulation, only valid for the current frame */
+		bool pressed(int key) const;
+		bool held(int key) const; // held on the keyboard or through hold()
+		double press_time(int key) const; // earliest press of the key, or the frame time if it was not pressed
+		double get_frame_time() const; // the time the frame is simulated at
+		float get_lead(int key) const; // fraction of a frame between the press and the simulation
+
+		/**  latency */
+		const latency_stats& get_latency() const;
+		void reset_latency();
+	private:
+		/**  guards what the window's thread samples and the simulation's thread takes */
+		mutable std::mutex mutex_;
+		std::vector<key_event> pending_; // sampled but not yet simulated
+		std::bitset<KEY_COUNT> down_; // keys held on the keyboard at the last sample
+		std::vector<double> undisplayed_; // press times waiting for the frame that shows them
+
+		/**  the simulation's own */
+		std::vector<key_event> frame_; // consumed by the current frame
+		std::bitset<KEY_COUNT> frame_down_; // held on the keyboard as the frame started
+		std::vector<int> held_; // keys held through hold()
+		bool keyboard_ = true;
+		bool concurrent_ = false;
+		double frame_time_ = 0.0;
+		latency_stats latency_;
+	};
+}
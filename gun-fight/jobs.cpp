@@ -0,0 +1,101 @@
+/*****************************************************************//**
+ * \file   jobs.cpp
+ * \brief  implementation file for the job pool
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "jobs.h"
+
+namespace {
+	thread_local jobs::pool* bound = nullptr;
+}
+
+jobs::pool::pool(unsigned int threads){
+	for (unsigned int i = 0; i < threads; ++i) {
+		queues_.push_back(std::make_unique<queue>());
+	}
+	for (std::size_t i = 0; i < threads; ++i) {
+		threads_.emplace_back([this, i](std::stop_token stop) { work(stop, i); });
+	}
+}
+
+/**  stopping wakes the sleeping workers, the threads are joined before the queues are freed */
+jobs::pool::~pool(){
+	threads_.clear();
+}
+
+unsigned int jobs::pool::get_threads() const {
+	return static_cast<unsigned int>(threads_.size());
+}
+
+/**  deal the ranges out in turn, starting one queue further along for each loop so
+ * loops started from several threads do not all land on the first worker */
+void jobs::pool::run(std::size_t count, std::size_t grain, call_fn call, void* body){
+	auto ranges = (count + grain - 1) / grain;
+	auto l = loop{ call, body, ranges };
+	auto first = next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+	queued_.fetch_add(ranges);
+	for (std::size_t r = 0; r < ranges; ++r) {
+		auto& q = *queues_[(first + r) % queues_.size()];
+		auto lock = std::lock_guard(q.mutex);
+		q.ranges.push_back(range{ &l, r * grain, std::min(count, (r + 1) * grain) });
+	}
+	/**  taking the lock orders the wake after any worker checking whether to sleep */
+	{
+		auto lock = std::lock_guard(sleep_mutex_);
+	}
+	wake_.notify_all();
+
+	/**  help until every range has been taken, then wait for the ones still running */
+	while (l.remaining.load(std::memory_order_acquire) > 0) {
+		if (not try_run(first)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool jobs::pool::try_run(std::size_t home){
+	auto r = range{};
+	auto found = false;
+	{
+		auto& q = *queues_[home];
+		auto lock = std::lock_guard(q.mutex);
+		if (not q.ranges.empty()) {
+			r = q.ranges.back();
+			q.ranges.pop_back();
+			found = true;
+		}
+	}
+	for (std::size_t i = 1; not found and i < queues_.size(); ++i) {
+		auto& q = *queues_[(home + i) % queues_.size()];
+		auto lock = std::lock_guard(q.mutex);
+		if (not q.ranges.empty()) {
+			r = q.ranges.front();
+			q.ranges.pop_front();
+			found = true;
+		}
+	}
+	if (not found) { return false; }
+	queued_.fetch_sub(1);
+	r.owner->call(r.owner->body, r.begin, r.end);
+	/**  the loop may be gone as soon as its last range is counted off */
+	r.owner->remaining.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+void jobs::pool::work(std::stop_token stop, std::size_t index){
+	while (not stop.stop_requested()) {
+		if (try_run(index)) { continue; }
+		auto lock = std::unique_lock(sleep_mutex_);
+		wake_.wait(lock, stop, [this] { return queued_.load() > 0; });
+	}
+}
+
+jobs::pool* jobs::bound_pool(){
+	return bound;
+}
+
+void jobs::bind_pool(pool* p){
+	bound = p;
+}
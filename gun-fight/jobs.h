@@ -0,0 +1,116 @@
+/*****************************************************************//**
+ * \file   jobs.h
+ * \brief  header file for the job pool, a fixed set of worker threads that
+ * share out loops. A loop is cut into ranges of indices and the ranges are
+ * dealt across the workers' queues. A worker takes ranges from the back of
+ * its own queue and, once that is empty, steals from the front of the
+ * others', so a worker given slow ranges is helped by the idle ones. The
+ * thread that starts a loop runs ranges too, then waits for the rest.
+ *
+ * Like the arena and the event bus the pool is bound to a thread. Loops on
+ * a thread with no pool bound run inline, so the server's workers, which
+ * already have a core each, never share out their matches' loops
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jobs {
+	class pool {
+	public:
+		/**  constructors and destructors, the default leaves a core for the calling thread */
+		~pool();
+		explicit pool(unsigned int threads = std::max(1u, std::thread::hardware_concurrency()) - 1);
+		pool(const pool&) = delete;
+		pool& operator=(const pool&) = delete;
+
+		/**  call body(begin, end) for ranges of grain indices covering [0, count), each range
+		 * starts at a multiple of grain. Returns once every range has run */
+		template<typename body_fn>
+		void parallel_for(std::size_t count, std::size_t grain, body_fn& body) {
+			run(count, grain, [](void* b, std::size_t begin, std::size_t end) { (*static_cast<body_fn*>(b))(begin, end); }, &body);
+		}
+		unsigned int get_threads() const;
+	private:
+		using call_fn = void(*)(void* body, std::size_t begin, std::size_t end);
+
+		/**  one parallel_for, it lives on the stack of the thread that started it */
+		struct loop {
+			call_fn call;
+			void* body;
+			std::atomic<std::size_t> remaining; // ranges not yet finished
+		};
+		struct range {
+			loop* owner;
+			std::size_t begin;
+			std::size_t end;
+		};
+		/**  the owning worker pops the back, thieves take the front */
+		struct queue {
+			std::mutex mutex;
+			std::deque<range> ranges;
+		};
+
+		void run(std::size_t count, std::size_t grain, call_fn call, void* body);
+		bool try_run(std::size_t home); // run one range, from the home queue first, false if there were none
+		void work(std::stop_token stop, std::size_t index);
+
+		std::vector<std::unique_ptr<queue>> queues_; // one per worker
+		std::atomic<std::size_t> queued_ = 0; // ranges waiting in any queue
+		std::atomic<std::size_t> next_queue_ = 0; // where the next loop starts dealing
+		std::mutex sleep_mutex_;
+		std::condition_variable_any wake_;
+		std::vector<std::jthread> threads_; // last, so the workers stop before the queues go
+	};
+
+	/**  the pool loops on this thread share, may be nullptr */
+	pool* bound_pool();
+	void bind_pool(pool* p);
+
+	/**  binds a pool for the lifetime of the scope */
+	class pool_scope {
+	public:
+		explicit pool_scope(pool& p) : previous_(bound_pool()) { bind_pool(&p); };
+		~pool_scope() { bind_pool(previous_); };
+		pool_scope(const pool_scope&) = delete;
+		pool_scope& operator=(const pool_scope&) = delete;
+	private:
+		pool* previous_;
+	};
+
+	/**  unbinds the pool for the lifetime of the scope, for work already shared out across the
+	 * pool whose own loops should not be shared again */
+	class inline_scope {
+	public:
+		inline_scope() : previous_(bound_pool()) { bind_pool(nullptr); };
+		~inline_scope() { bind_pool(previous_); };
+		inline_scope(const inline_scope&) = delete;
+		inline_scope& operator=(const inline_scope&) = delete;
+	private:
+		pool* previous_;
+	};
+
+	/**  share the loop with the bound pool, or run the ranges in order on this thread. A loop
+	 * of one range is always run here, it is not worth waking a worker for */
+	template<typename body_fn>
+	void parallel_for(std::size_t count, std::size_t grain, body_fn body) {
+		auto p = bound_pool();
+		if (p == nullptr or p->get_threads() == 0 or count <= grain) {
+			for (std::size_t begin = 0; begin < count; begin += grain) {
+				body(begin, std::min(count, begin + grain));
+			}
+			return;
+		}
+		p->parallel_for(count, grain, body);
+	}
+}
@@ -0,0 +1,138 @@
+/*****************************************************************//**
+ * \file   killcam.cpp
+ * \brief  implementation file for the kill cam
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "killcam.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace {
+	/**  the rest of the scene is dimmed so the killing projectile stands out */
+	constexpr Color DIMMED = { 140, 140, 140, 255 };
+	constexpr std::uint8_t NO_SHEET = std::numeric_limits<std::uint8_t>::max();
+
+	std::int16_t to_i16(float value) {
+		return static_cast<std::int16_t>(std::clamp(std::lround(value), long{ INT16_MIN }, long{ INT16_MAX }));
+	}
+
+	std::uint16_t to_u16(float value) {
+		return static_cast<std::uint16_t>(std::clamp(std::lround(value), long{ 0 }, long{ UINT16_MAX }));
+	}
+
+	/**  entities are never moved in memory, so their address tells them apart between ticks */
+	std::uint32_t key_of(const entities::entity* e) {
+		return static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(e) >> 4);
+	}
+}
+
+killcam::recorder::recorder()
+	: sprites_(config::KILLCAM_FRAMES * config::KILLCAM_MAX_SPRITES), counts_(config::KILLCAM_FRAMES) {
+	sheets_.reserve(config::KILLCAM_MAX_SHEETS);
+}
+
+/**  the slot after the newest is the oldest, once the ring has been round once */
+void killcam::recorder::record(const std::vector<std::shared_ptr<entities::entity>>& entities){
+	PROFILE_ZONE("record_killcam");
+	newest_ = (newest_ + 1) % config::KILLCAM_FRAMES;
+	size_ = std::min(size_ + 1, config::KILLCAM_FRAMES);
+	auto out = sprites_.data() + newest_ * config::KILLCAM_MAX_SPRITES;
+	auto count = std::uint32_t{ 0 };
+	for (auto& e : entities) {
+		if (count == config::KILLCAM_MAX_SPRITES) {
+			truncated_ += entities.size() - count;
+			break;
+		}
+		auto anim = e->get_animation();
+		auto sheet = sheet_index(anim.get_sheet());
+		if (sheet == NO_SHEET) {
+			++truncated_;
+			continue;
+		}
+		auto source = anim.get_current_frame();
+		out[count++] = sprite{ key_of(e.get()), to_i16(e->get_x()), to_i16(e->get_y()), to_i16(e->get_y() + anim.get_frame_height()),
+			to_u16(source.x), to_u16(source.y), to_u16(source.width), to_u16(source.height),
+			sheet, static_cast<std::uint8_t>(e->get_layer()) };
+	}
+	counts_[newest_] = count;
+}
+
+/**  the projectile covering the hit in the newest frame that has one. A bullet is gone by the tick
+ * its hit lands, so it is found in the frame before, where it was drawn at the point it hit */
+void killcam::recorder::mark_kill(Vector2 hit){
+	kill_ = true;
+	killer_ = 0;
+	for (std::size_t age = 0; age < size_ and killer_ == 0; ++age) {
+		auto sprites = sprites_of(age);
+		for (std::uint32_t i = 0; i < counts_[slot_of(age)]; ++i) {
+			auto& s = sprites[i];
+			auto area = Rectangle{ s.x - 1.0f, s.y - 1.0f, s.source_width + 2.0f, s.source_height + 2.0f };
+			if (s.layer == render::PROJECTILES and CheckCollisionPointRec(hit, area)) {
+				killer_ = s.key;
+				break;
+			}
+		}
+	}
+}
+
+bool killcam::recorder::has_kill() const {
+	return kill_ and size_ > 0;
+}
+
+double killcam::recorder::get_length() const {
+	if (not has_kill()) { return 0.0; }
+	return size_ / (config::TARGET_FPS * config::KILLCAM_SPEED);
+}
+
+/**  played from the oldest frame to the newest */
+void killcam::recorder::draw(double elapsed, render::render_queue& queue) const {
+	if (size_ == 0) { return; }
+	auto shown = static_cast<std::size_t>(std::max(0.0, elapsed * config::TARGET_FPS * config::KILLCAM_SPEED));
+	auto age = size_ - 1 - std::min(shown, size_ - 1);
+	auto sprites = sprites_of(age);
+	for (std::uint32_t i = 0; i < counts_[slot_of(age)]; ++i) {
+		auto& s = sprites[i];
+		auto source = Rectangle{ float(s.source_x), float(s.source_y), float(s.source_width), float(s.source_height) };
+		auto position = Vector2{ float(s.x), float(s.y) };
+		if (killer_ != 0 and s.key == killer_) {
+			queue.submit(render::OVERLAY, s.sort_y, sheets_[s.sheet], source, position);
+		}
+		else {
+			queue.submit(s.layer, s.sort_y, sheets_[s.sheet], source, position, DIMMED);
+		}
+	}
+}
+
+/**  the sheets are kept, the next round draws from the same ones */
+void killcam::recorder::clear(){
+	size_ = 0;
+	kill_ = false;
+	killer_ = 0;
+}
+
+killcam::recorder_stats killcam::recorder::get_stats() const {
+	return recorder_stats{ size_, truncated_ };
+}
+
+/**  a handful of sheets are in play, a linear search beats hashing */
+std::uint8_t killcam::recorder::sheet_index(Texture2D sheet){
+	for (std::size_t i = 0; i < sheets_.size(); ++i) {
+		if (sheets_[i].id == sheet.id) { return static_cast<std::uint8_t>(i); }
+	}
+	if (sheets_.size() == config::KILLCAM_MAX_SHEETS) { return NO_SHEET; }
+	sheets_.push_back(sheet);
+	return static_cast<std::uint8_t>(sheets_.size() - 1);
+}
+
+const killcam::sprite* killcam::recorder::sprites_of(std::size_t age) const {
+	return sprites_.data() + slot_of(age) * config::KILLCAM_MAX_SPRITES;
+}
+
+std::size_t killcam::recorder::slot_of(std::size_t age) const {
+	return (newest_ + config::KILLCAM_FRAMES - age) % config::KILLCAM_FRAMES;
+}
@@ -0,0 +1,80 @@
+/*****************************************************************//**
+ * \file   killcam.h
+ * \brief  header file for the kill cam. Every tick of a round the entities
+ * are recorded as compact sprites, one small fixed size record each, into a
+ * ring that holds the last config::KILLCAM_FRAMES ticks. The ring and the
+ * table of sheets are allocated once, so recording is a copy into memory
+ * that is already there and the memory used never grows. A tick with more
+ * sprites than a frame holds keeps the first ones.
+ *
+ * When a gunman is killed the projectile that hit them is found in the
+ * newest frames, by the point the hit was published at, and the ring is
+ * played back in slow motion with that projectile drawn over everything
+ * else and the rest of the scene dimmed
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "entities.h"
+#include "render_queue.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace killcam {
+	/**  one entity in one frame, sheets are indices into the recorder's table */
+	struct sprite {
+		std::uint32_t key = 0; // the same entity has the same key in every frame it is in
+		std::int16_t x = 0;
+		std::int16_t y = 0;
+		std::int16_t sort_y = 0;
+		std::uint16_t source_x = 0;
+		std::uint16_t source_y = 0;
+		std::uint16_t source_width = 0;
+		std::uint16_t source_height = 0;
+		std::uint8_t sheet = 0;
+		std::uint8_t layer = 0;
+	};
+
+	struct recorder_stats {
+		std::size_t frames = 0; // ticks held, at most config::KILLCAM_FRAMES
+		std::size_t truncated = 0; // sprites not recorded because their frame was full
+	};
+
+	class recorder {
+	public:
+		/**  constructors and destructors */
+		~recorder() = default;
+		recorder();
+		recorder(const recorder&) = delete;
+		recorder& operator=(const recorder&) = delete;
+
+		/**  record one tick, overwriting the oldest once the ring is full */
+		void record(const std::vector<std::shared_ptr<entities::entity>>& entities);
+		/**  a gunman was killed by a hit at this point, the replay highlights what hit them */
+		void mark_kill(Vector2 hit);
+		bool has_kill() const;
+		/**  seconds the replay lasts, 0 without a kill */
+		double get_length() const;
+		/**  queue the frame shown elapsed seconds into the replay, the last frame once it is over */
+		void draw(double elapsed, render::render_queue& queue) const;
+		/**  forget every frame and the kill, for a new round */
+		void clear();
+		recorder_stats get_stats() const;
+	private:
+		std::uint8_t sheet_index(Texture2D sheet);
+		const sprite* sprites_of(std::size_t age) const; // age 0 is the newest frame
+		std::size_t slot_of(std::size_t age) const;
+
+		std::vector<sprite> sprites_; // config::KILLCAM_FRAMES blocks of config::KILLCAM_MAX_SPRITES
+		std::vector<std::uint32_t> counts_; // sprites used in each frame's block
+		std::vector<Texture2D> sheets_; // capacity reserved up front, never grows past it
+		std::size_t newest_ = 0;
+		std::size_t size_ = 0;
+		std::size_t truncated_ = 0;
+		std::uint32_t killer_ = 0;
+		bool kill_ = false;
+	};
+}
@@ -7,6 +7,7 @@
  *********************************************************************/
 #include "level_builder.h"
 #include "utility.h"
+#include "arena.h"
 #include <iostream>
 #include <iterator>
 #include <cmath>
@@ -15,7 +16,7 @@ float clamp(float value, float min, float max) {
 	return std::fmax(min, std::fmin(value, max));
 }
 /** checks if the obstacle can be added at the proposed position, some bugs persist, TODO change */
-bool can_insert_obstacle(Rectangle insert_rectangle, const std::set<std::unique_ptr<entities::entity>, decltype(util::cmp)>& entities) {
+bool can_insert_obstacle(Rectangle insert_rectangle, const std::set<std::shared_ptr<entities::entity>, decltype(util::cmp)>& entities) {
 	for (auto& e : entities) {
 		// Get the current rectangle
 		Rectangle current_rectangle = e->get_rectangle();
@@ -35,16 +36,16 @@ void level::level::build_level(){
 	/**  generate two numbers between 1 and 3, to determine which obstacles to generate */
 	auto obstacle_categories = std::set<int>{};
 	for (auto i = 0; i < level_category_; ++i) {
-		obstacle_categories.insert(util::generate_random_int(config::TUMBLEWEED_CATEGORY, config::WAGON_CATEGORY));
+		obstacle_categories.insert(util::generate_random_int(archetype::TUMBLEWEED.category, archetype::WAGON.category));
 	}
-	if (obstacle_categories.contains(config::TUMBLEWEED_CATEGORY)) { 
+	if (obstacle_categories.contains(archetype::TUMBLEWEED.category)) { 
 		build_tumbleweed(); 
 	}
-	if (obstacle_categories.contains(config::CACTUS_CATEGORY)) { 
+	if (obstacle_categories.contains(archetype::CACTUS.category)) { 
 		build_cacti(); }
-	if (obstacle_categories.contains(config::BARREL_CATEGORY)) {
+	if (obstacle_categories.contains(archetype::BARREL.category)) {
 		build_barrels(); }
-	if (obstacle_categories.contains(config::WAGON_CATEGORY)) { build_wagons(); }
+	if (obstacle_categories.contains(archetype::WAGON.category)) { build_wagons(); }
 	// then generate up to level_category unique numbers between 0 and 3 
 
 	// if the set contains the obstacle category, generate that obstacle 
@@ -55,18 +56,18 @@ void level::level::build_tumbleweed(){
 	obstacles_to_generate_ -= num_tumbleweed;
 	for (auto i = 0; i < num_tumbleweed; ++i) {
 		
-		auto random_x = util::generate_random_num<float>(config::OBSTACLE_RANGE_X + config::TUMBLEWEED_WIDTH, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - config::TUMBLEWEED_WIDTH);
-		auto random_y = util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + config::TUMBLEWEED_HEIGHT, config::OBSTACLE_RANGE_HEIGHT - config::TUMBLEWEED_HEIGHT);
+		auto random_x = util::generate_random_num<float>(config::OBSTACLE_RANGE_X + archetype::TUMBLEWEED.width, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - archetype::TUMBLEWEED.width);
+		auto random_y = util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + archetype::TUMBLEWEED.height, config::OBSTACLE_RANGE_HEIGHT - archetype::TUMBLEWEED.height);
 		auto tumbleweed = std::make_unique<entities::tumbleweed>(entities::tumbleweed(
 			static_cast<float>(random_x), static_cast<float>(random_y)));
 		auto num_attempts = 0;
 		while (not can_insert_obstacle(tumbleweed->get_rectangle(), level_entities_) and num_attempts < 20) {
-			tumbleweed->set_pos(util::generate_random_num<float>(config::OBSTACLE_RANGE_X + config::TUMBLEWEED_WIDTH, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - config::TUMBLEWEED_WIDTH),
-				util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + config::TUMBLEWEED_HEIGHT,config::OBSTACLE_RANGE_HEIGHT - config::TUMBLEWEED_HEIGHT));
+			tumbleweed->set_pos(util::generate_random_num<float>(config::OBSTACLE_RANGE_X + archetype::TUMBLEWEED.width, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - archetype::TUMBLEWEED.width),
+				util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + archetype::TUMBLEWEED.height,config::OBSTACLE_RANGE_HEIGHT - archetype::TUMBLEWEED.height));
 			++num_attempts;
 		}
 		if (num_attempts < 20) {
-			level_entities_.insert(std::make_unique<entities::tumbleweed>(*tumbleweed.get()));
+			level_entities_.insert(memory::make_round<entities::tumbleweed>(*tumbleweed.get()));
 		}
 	}
 }
@@ -78,8 +79,8 @@ void level::level::build_cacti(){
 	// if empty, just pick a random position and add the entity there	
 	for (auto i = 0; i < num_cacti; ++i) {
 		/**  generate a random position within the bounds defined in the config file  */
-		auto random_x = util::generate_random_num(config::OBSTACLE_RANGE_X + config::CACTUS_WIDTH, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - config::CACTUS_WIDTH);
-		auto random_y = util::generate_random_num(config::OBSTACLE_RANGE_Y + config::CACTUS_HEIGHT, config::OBSTACLE_RANGE_HEIGHT - config::CACTUS_HEIGHT);
+		auto random_x = util::generate_random_num(config::OBSTACLE_RANGE_X + archetype::CACTUS.width, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - archetype::CACTUS.width);
+		auto random_y = util::generate_random_num(config::OBSTACLE_RANGE_Y + archetype::CACTUS.height, config::OBSTACLE_RANGE_HEIGHT - archetype::CACTUS.height);
 		auto cactus = std::make_unique<entities::cactus>(entities::cactus(
 			static_cast<float>(random_x), static_cast<float>(random_y)));
 		
@@ -87,13 +88,13 @@ void level::level::build_cacti(){
 		auto num_attempts = 0;
 		while (not can_insert_obstacle(cactus->get_rectangle(), level_entities_) and num_attempts < 20) {
 
-			cactus->set_pos(static_cast<float>(util::generate_random_num(config::OBSTACLE_RANGE_X + config::CACTUS_WIDTH, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - config::CACTUS_WIDTH)),
-				static_cast<float>(util::generate_random_num(config::OBSTACLE_RANGE_Y + config::CACTUS_HEIGHT, config::OBSTACLE_RANGE_HEIGHT - config::CACTUS_HEIGHT)));
+			cactus->set_pos(static_cast<float>(util::generate_random_num(config::OBSTACLE_RANGE_X + archetype::CACTUS.width, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - archetype::CACTUS.width)),
+				static_cast<float>(util::generate_random_num(config::OBSTACLE_RANGE_Y + archetype::CACTUS.height, config::OBSTACLE_RANGE_HEIGHT - archetype::CACTUS.height)));
 			++num_attempts;
 		}
 		/**  if it can be inserted in the level, do so */
 		if (num_attempts < 20) {
-			level_entities_.insert(std::make_unique<entities::cactus>(*cactus.get()));
+			level_entities_.insert(memory::make_round<entities::cactus>(*cactus.get()));
 		}
 	}
 }
@@ -102,21 +103,21 @@ void level::level::build_barrels(){
 	int num_barrels = ceil(obstacles_to_generate_ * util::generate_random_num<double>(0.2, 0.4));
 	obstacles_to_generate_ -= num_barrels;
 	for (auto i = 0; i < num_barrels; ++i) {
-		auto random_x = util::generate_random_num<float>(config::OBSTACLE_RANGE_X + config::BARREL_WIDTH, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - config::BARREL_WIDTH);
-		auto random_y = util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + config::BARREL_HEIGHT, config::OBSTACLE_RANGE_HEIGHT - config::BARREL_HEIGHT);
+		auto random_x = util::generate_random_num<float>(config::OBSTACLE_RANGE_X + archetype::BARREL.width, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - archetype::BARREL.width);
+		auto random_y = util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + archetype::BARREL.height, config::OBSTACLE_RANGE_HEIGHT - archetype::BARREL.height);
 		auto barrel = std::make_unique<entities::barrel>(entities::barrel(
 			static_cast<float>(random_x), static_cast<float>(random_y)));
 
 		auto num_attempts = 0;
 		while (not can_insert_obstacle(barrel->get_rectangle(), level_entities_) and num_attempts < 20) {
 
-			barrel->set_pos(util::generate_random_num<float>(config::OBSTACLE_RANGE_X + config::BARREL_WIDTH, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - config::BARREL_WIDTH),
-				util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + config::BARREL_HEIGHT, config::OBSTACLE_RANGE_HEIGHT - config::BARREL_HEIGHT));
+			barrel->set_pos(util::generate_random_num<float>(config::OBSTACLE_RANGE_X + archetype::BARREL.width, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - archetype::BARREL.width),
+				util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + archetype::BARREL.height, config::OBSTACLE_RANGE_HEIGHT - archetype::BARREL.height));
 		
 			++num_attempts;
 		}
 		if (num_attempts < 20) {
-			level_entities_.insert(std::make_unique<entities::barrel>(*barrel.get()));
+			level_entities_.insert(memory::make_round<entities::barrel>(*barrel.get()));
 		}
 	}
 }
@@ -125,20 +126,20 @@ void level::level::build_wagons(){
 	int num_wagons = ceil(obstacles_to_generate_ * util::generate_random_num<double>(0.3, 0.6));
 	obstacles_to_generate_ -= num_wagons;
 	for (auto i = 0; i < num_wagons; ++i) {
-		auto random_x = util::generate_random_num<float>(config::OBSTACLE_RANGE_X + config::WAGON_DOWN_WIDTH, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - config::WAGON_DOWN_WIDTH);
-		auto random_y = util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + config::WAGON_DOWN_HEIGHT, config::OBSTACLE_RANGE_HEIGHT - config::WAGON_DOWN_HEIGHT);
+		auto random_x = util::generate_random_num<float>(config::OBSTACLE_RANGE_X + archetype::WAGON.width, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - archetype::WAGON.width);
+		auto random_y = util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + archetype::WAGON.height, config::OBSTACLE_RANGE_HEIGHT - archetype::WAGON.height);
 		auto wagon = std::make_unique<entities::wagon>(entities::wagon(
-			static_cast<float>(random_x), static_cast<float>(random_y), 0.0, config::WAGON_SPEED));
+			static_cast<float>(random_x), static_cast<float>(random_y), 0.0, archetype::WAGON.speed));
 		
 		auto num_attempts = 0;
 		while (not can_insert_obstacle(wagon->get_rectangle(), level_entities_) and num_attempts < 20) {
 
-			wagon->set_pos(util::generate_random_num<float>(config::OBSTACLE_RANGE_X + config::WAGON_DOWN_WIDTH, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - config::WAGON_DOWN_WIDTH),
-				util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + config::WAGON_DOWN_HEIGHT, config::OBSTACLE_RANGE_HEIGHT - config::WAGON_DOWN_HEIGHT));
+			wagon->set_pos(util::generate_random_num<float>(config::OBSTACLE_RANGE_X + archetype::WAGON.width, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH - archetype::WAGON.width),
+				util::generate_random_num<float>(config::OBSTACLE_RANGE_Y + archetype::WAGON.height, config::OBSTACLE_RANGE_HEIGHT - archetype::WAGON.height));
 			++num_attempts;
 		}
 		if (num_attempts < 20) {
-			level_entities_.insert(std::make_unique<entities::wagon>(*wagon.get()));
+			level_entities_.insert(memory::make_round<entities::wagon>(*wagon.get()));
 		}
 	}
 }
@@ -147,6 +148,6 @@ void level::level::build_train() {
 	return;
 }
 
-std::set<std::unique_ptr<entities::entity>, decltype(util::cmp)>& level::level_builder::get_level_entities() {
+std::set<std::shared_ptr<entities::entity>, decltype(util::cmp)>& level::level_builder::get_level_entities() {
 	return level_entities_;
 }
@@ -11,6 +11,9 @@
 #include "utility.h"
 #include <random>
 #include <set>
+/**  true if the rectangle is far enough from every obstacle already placed */
+bool can_insert_obstacle(Rectangle insert_rectangle, const std::set<std::shared_ptr<entities::entity>, decltype(util::cmp)>& entities);
+
 namespace level {
 	class level_builder {
 	public:
@@ -28,11 +31,11 @@ namespace level {
 		virtual void build_barrels() = 0;
 		virtual void build_wagons() = 0;
 		virtual void build_train() = 0;
-		std::set<std::unique_ptr<entities::entity>, decltype(util::cmp)>& get_level_entities();
+		std::set<std::shared_ptr<entities::entity>, decltype(util::cmp)>& get_level_entities();
 
 	protected:
 		// you can move the pointers to the game_entities after building
-		std::set<std::unique_ptr<entities::entity>, decltype(util::cmp)> level_entities_ = {};
+		std::set<std::shared_ptr<entities::entity>, decltype(util::cmp)> level_entities_ = {};
 		int level_category_;
 		int obstacles_to_generate_;
 	};
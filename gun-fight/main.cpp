@@ -13,38 +13,124 @@
 #include "entities.h"
 #include "config.h"
 #include "utility.h"
+#include "audio.h"
 #include "level_builder.h"
 #include "game_manager.h"
 #include "player.h"
 #include "screen.h"
 #include "button.h"
+#include "scene.h"
+#include "stress.h"
+#include "spectator.h"
+#include "server.h"
+#include "jobs.h"
+#include <fstream>
+#include <string>
+#include <cctype>
+#include <cstdlib>
+
+/**
+ * gun_fight.exe [--stress scenario.txt [--headless]] [--broadcast] [--spectate address]
+ *               [--server [matches] [--seconds n]] [--connect address]
+ * runs the stress mode instead of the game, headless runs without a window or audio.
+ * broadcast streams the game to spectators, spectate watches a game broadcast from another machine.
+ * server hosts many headless matches, connect plays on one of them
+ */
+int main(int argc, char* argv[]) {
+	const char* scenario_path = nullptr;
+	const char* spectate_address = nullptr;
+	const char* connect_address = nullptr;
+	auto headless = false;
+	auto broadcast = false;
+	auto hosting = false;
+	auto server_options = server::options{};
+	for (auto i = 1; i < argc; ++i) {
+		auto arg = std::string(argv[i]);
+		if (arg == "--stress" and i + 1 < argc) { scenario_path = argv[++i]; }
+		else if (arg == "--headless") { headless = true; }
+		else if (arg == "--broadcast") { broadcast = true; }
+		else if (arg == "--spectate" and i + 1 < argc) { spectate_address = argv[++i]; }
+		else if (arg == "--connect" and i + 1 < argc) { connect_address = argv[++i]; }
+		else if (arg == "--server") {
+			hosting = true;
+			if (i + 1 < argc and std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) { server_options.matches = std::atoi(argv[++i]); }
+		}
+		else if (arg == "--seconds" and i + 1 < argc) { server_options.seconds = std::atof(argv[++i]); }
+	}
+	headless = headless and scenario_path != nullptr;
+
+	/**  dedicated server, no window or audio */
+	if (hosting) {
+		return server::run(server_options);
+	}
+
+	/**  spectator and client modes, draw a game simulated elsewhere */
+	if (spectate_address != nullptr or connect_address != nullptr) {
+		auto spectating = spectate_address != nullptr;
+		auto address = spectating ? spectate_address : connect_address;
+		auto game = net::parse_endpoint(address, spectating ? config::SPECTATOR_PORT : config::SERVER_PORT);
+		if (not game) {
+			std::cout << "could not parse the address " << address << std::endl;
+			return 1;
+		}
+		SetTargetFPS(config::TARGET_FPS);
+		InitWindow(config::SCREEN_WIDTH, config::SCREEN_HEIGHT, spectating ? "gun_fight.exe - spectating" : "gun_fight.exe - online");
+		if (spectating) {
+			spectator::run_viewer(*game);
+		}
+		else {
+			server::run_client(*game);
+		}
+		/**  the viewer loads the sheets it draws, they are freed while the window still exists */
+		resources::unload_textures();
+		CloseWindow();
+		return 0;
+	}
 
-static void init_game(game_manager& manager);
-static void update_game(game_manager& manager);
-static void draw_game(game_manager& manager);
-static void unload_game();
-static void update_draw_frame(game_manager& manager);
-int main() {	
 	/**  initalise the window */
-	SetTargetFPS(60);
-	InitWindow(config::SCREEN_WIDTH, config::SCREEN_HEIGHT, "gun_fight.exe");
-	InitAudioDevice();
-	/** make the gunman and weapon for both players */
-	auto gunman_1 = std::make_shared<entities::gunman>(entities::gunman(config::P1_START_X, config::P1_START_Y, config::P1_PATH, 1, 1));
-	auto gunamn_centre_x = gunman_1->get_x() + config::GUNMAN_WIDTH / 2;
-	auto weapon_x = gunamn_centre_x + ((config::GUNMAN_WIDTH / 2) + config::BULLET_WIDTH) * gunman_1->get_direction();
-	auto weapon_1 = std::make_shared<entities::revolver>(entities::revolver(weapon_x, gunman_1->get_y() + 45, config::REVOLVER_PATH));
-	auto player_1 = player(gunman_1, weapon_1, config::GUNMAN1_MOVEMENT, config::GUNMAN1_FIRING, config::P1_ITEM_KEY,  150, config::P1_WIN_PATH);
+	if (headless) {
+		resources::set_headless(true);
+	}
+	else {
+		SetTargetFPS(config::TARGET_FPS);
+		InitWindow(config::SCREEN_WIDTH, config::SCREEN_HEIGHT, "gun_fight.exe");
+		InitAudioDevice();
+		for (auto path : config::VOICE_LINES) {
+			audio::open_stream(path);
+		}
+	}
+	/**  the entities' update is shared with a worker on each of the other cores */
+	auto workers = jobs::pool();
+	auto jobs_scope = jobs::pool_scope(workers);
 
-	auto gunman_2 = std::make_shared<entities::gunman>(entities::gunman(config::P2_START_X, config::P2_START_Y, config::P2_PATH, 1, -1));
-	gunamn_centre_x = gunman_2->get_x() + config::GUNMAN_WIDTH / 2;
-	weapon_x = gunamn_centre_x + ((config::GUNMAN_WIDTH / 2) + config::BULLET_WIDTH) * gunman_2->get_direction();
-	auto weapon_2 = std::make_shared<entities::revolver>(entities::revolver(weapon_x, gunman_2->get_y() + 45, config::REVOLVER_PATH));
-	
-	auto player_2 = player(gunman_2, weapon_2, config::GUNMAN2_MOVEMENT, config::GUNMAN2_FIRING, config::P2_ITEM_KEY, config::SCREEN_WIDTH - 150, config::P2_WIN_PATH);
+	/** make the gunman and weapon for both players */
+	auto player_1 = player::create(1);
+	auto player_2 = player::create(2);
 
 	/**  create the game manager */
 	auto manager = game_manager(player_1, player_2);
+	if (broadcast) {
+		manager.enable_spectators(config::SPECTATOR_PORT);
+	}
+
+	/**  stress mode, ramp entity counts until the frame budget is exceeded then write the report */
+	if (scenario_path != nullptr) {
+		auto scenario = stress::load_scenario(scenario_path);
+		if (scenario) {
+			if (not headless) { SetTargetFPS(0); }
+			auto report = stress::format_report(*scenario, stress::run(manager, *scenario, headless));
+			std::ofstream(config::STRESS_REPORT_PATH) << report;
+			std::cout << report;
+		}
+		if (not headless) {
+			audio::unload();
+			CloseAudioDevice();
+			CloseWindow();
+		}
+		return scenario ? 0 : 1;
+	}
+	/**  kills are replayed in the game, not in the stress mode */
+	manager.enable_killcam();
 	/**  create the main menu buttons TODO add credits button */
 	auto menu_buttons = std::vector<button>{
 		button(config::PLAY_PATH, config::BUTTON_WIDTH, config::BUTTON_HEIGHT, config::SCREEN_WIDTH_HALF - (config::BUTTON_WIDTH / 2), config::BUTTONS_START_Y),
@@ -58,116 +144,17 @@ int main() {
 	/**  create the main menu and controls screens */
 	auto main_menu = screen(config::MENU_PATH, config::SCREEN_WIDTH, config::SCREEN_HEIGHT, 1, 0, 50, menu_buttons.begin(), menu_buttons.end(), std::make_unique<main_menu_strategy>(main_menu_strategy()));
 	auto control_screen  = screen(config::CONTROL_SCREEN_PATH, config::SCREEN_WIDTH, config::SCREEN_HEIGHT, 1, 0, 0, control_buttons.begin(), control_buttons.end(), std::make_unique<return_strategy>(return_strategy()));
-	/**  prevents abrupt exiting of the game with an exception */
-	auto exit = false;
+	/**  the scenes are ticked once per frame, none of them block the loop */
+	auto scenes = scene_manager(manager, main_menu, control_screen);
 	/**  main game loop */
-	while (not WindowShouldClose() and not exit) {
-		/** check if a button on the main menu is prsesed */
-		auto button = main_menu.update();
-		switch (button) {
-			/**  the play button */
-			case 0: {
-				/**  primary gameplay loop */
-				/**  initialise the game  */
-				init_game(manager);
-				while (not WindowShouldClose() and not manager.game_over()) {
-					if (manager.is_round_over()) {
-						/**  reset the round if finished */
-						manager.post_round();
-						init_game(manager);
-					}
-					/**  update and draw the current frame */
-					update_draw_frame(manager);
-				}
-				if (WindowShouldClose()) {
-					break;
-					CloseWindow();
-				}
-				/**
-				 * after the game is over, play a game over screen
-				 * go back to the main menu. 
-				 */
-				else {
-					auto start_time = GetTime();
-					// wait a second 
-					WaitTime(1);
-					manager.play_voiceline();
-					while (GetTime() - start_time < 4.05) {
-						BeginDrawing();
-						manager.draw_background();
-						manager.draw_players();
-						manager.draw_win();
-						EndDrawing();
-					}
-					manager.reset_scores();
-					unload_game();
-				}
-				break;
-			} 
-			/**  keyboard controls screen */
-			case 1: {// controls
-				while (not WindowShouldClose()) {
-					/**  check if the return button is pressed */
-					control_screen.draw();
-					auto button = control_screen.update();
-					if (button == 0) {
-						break;
-					}
-				}
-				break;
-			}
-			/**  quit button */
-			case 2: { // exit
-				exit = true;
-				break;
-			}
-			default: {
-				break;
-			}
-		}
-		main_menu.draw();
+	while (not WindowShouldClose() and not scenes.should_quit()) {
+		scenes.update();
+		scenes.draw();
 	}
+	/**  a window closed mid round leaves the simulation ticking, it is stopped before anything it uses is closed */
+	scenes.shutdown();
+	audio::unload();
 	CloseAudioDevice();
 	CloseWindow();
 	return 1;
 }
-
-// --------------------- game updating, drawing and initalisation--------------------------------
-
-void init_game(game_manager& manager) {
-	manager.build_level();
-	manager.pre_round();
-}
-
-// update the game by one frame
-void update_game(game_manager& manager) {
-	// temp for quickly cycling through rounds to test environment generation
-	if (IsKeyPressed(KEY_X)) {
-		manager.end_round();
-	}
-
-	// update players, check they are alive, increase scores, end the round
-	manager.update_players();
-
-	// check and spawn items if enough time has elapsed
-	manager.spawn_items();
-	// then update entnties
-	manager.update_entities();
-
-	// and remove them 
-	manager.remove_entities();
-	// then increase frame_count 
-	manager.increment_frame_count();
-}
-void draw_game(game_manager& manager) {
-	BeginDrawing();
-	manager.draw_game();
-	EndDrawing();
-}
-
-void unload_game(){
-}
-void update_draw_frame(game_manager& manager) {
-	update_game(manager);
-	draw_game(manager);
-}
@@ -0,0 +1,110 @@
+/*****************************************************************//**
+ * \file   net.cpp
+ * \brief  implementation file for the UDP socket
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "net.h"
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+	/**  winsock has to be started once before the first socket */
+	bool start_sockets() {
+		static const bool started = [] {
+			auto data = WSADATA{};
+			return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+		}();
+		return started;
+	}
+	void close_socket(std::intptr_t handle) { closesocket(static_cast<SOCKET>(handle)); }
+	bool set_non_blocking(std::intptr_t handle) {
+		auto mode = u_long{ 1 };
+		return ioctlsocket(static_cast<SOCKET>(handle), FIONBIO, &mode) == 0;
+	}
+#else
+	bool start_sockets() { return true; }
+	void close_socket(std::intptr_t handle) { ::close(static_cast<int>(handle)); }
+	bool set_non_blocking(std::intptr_t handle) {
+		auto flags = fcntl(static_cast<int>(handle), F_GETFL, 0);
+		return flags != -1 and fcntl(static_cast<int>(handle), F_SETFL, flags | O_NONBLOCK) == 0;
+	}
+#endif
+
+	sockaddr_in to_address(const net::endpoint& e) {
+		auto address = sockaddr_in{};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(e.address);
+		address.sin_port = htons(e.port);
+		return address;
+	}
+}
+
+std::optional<net::endpoint> net::parse_endpoint(const char* host, std::uint16_t port){
+	if (std::strcmp(host, "localhost") == 0) { host = "127.0.0.1"; }
+	auto address = in_addr{};
+	if (inet_pton(AF_INET, host, &address) != 1) { return std::nullopt; }
+	return endpoint{ ntohl(address.s_addr), port };
+}
+
+net::udp_socket::~udp_socket(){
+	close();
+}
+
+bool net::udp_socket::open(std::uint16_t port){
+	close();
+	if (not start_sockets()) { return false; }
+	auto handle = static_cast<std::intptr_t>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+	if (handle < 0) { return false; }
+	auto address = to_address(endpoint{ INADDR_ANY, port });
+	if (bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 or not set_non_blocking(handle)) {
+		close_socket(handle);
+		return false;
+	}
+	handle_ = handle;
+	return true;
+}
+
+bool net::udp_socket::is_open() const {
+	return handle_ >= 0;
+}
+
+void net::udp_socket::close(){
+	if (is_open()) {
+		close_socket(handle_);
+		handle_ = -1;
+	}
+}
+
+bool net::udp_socket::send(const endpoint& to, const std::uint8_t* data, std::size_t size){
+	if (not is_open()) { return false; }
+	auto address = to_address(to);
+	auto sent = sendto(handle_, reinterpret_cast<const char*>(data), static_cast<int>(size), 0,
+		reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+	return sent == static_cast<decltype(sent)>(size);
+}
+
+std::size_t net::udp_socket::receive(std::uint8_t* buffer, std::size_t size, endpoint& from){
+	if (not is_open()) { return 0; }
+	auto address = sockaddr_in{};
+	auto length = static_cast<socklen_t>(sizeof(address));
+	auto read = recvfrom(handle_, reinterpret_cast<char*>(buffer), static_cast<int>(size), 0,
+		reinterpret_cast<sockaddr*>(&address), &length);
+	if (read <= 0) { return 0; }
+	from = endpoint{ ntohl(address.sin_addr.s_addr), ntohs(address.sin_port) };
+	return static_cast<std::size_t>(read);
+}
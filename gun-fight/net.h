@@ -0,0 +1,45 @@
+/*****************************************************************//**
+ * \file   net.h
+ * \brief  header file for a minimal non-blocking UDP socket, used by the
+ * spectator stream. IPv4 only, the stream is meant for screens on the local
+ * network. Kept apart from raylib, winsock and raylib declare clashing names
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace net {
+	/**  an IPv4 address and port, both in host byte order */
+	struct endpoint {
+		std::uint32_t address = 0;
+		std::uint16_t port = 0;
+		bool operator==(const endpoint& other) const = default;
+	};
+
+	/**  a dotted IPv4 address or "localhost", nullopt if it cannot be parsed */
+	std::optional<endpoint> parse_endpoint(const char* host, std::uint16_t port);
+
+	class udp_socket {
+	public:
+		/**  constructors and destructors */
+		~udp_socket();
+		udp_socket() = default;
+		udp_socket(const udp_socket&) = delete;
+		udp_socket& operator=(const udp_socket&) = delete;
+
+		/**  bind to a port on every interface, 0 picks any free port */
+		bool open(std::uint16_t port);
+		bool is_open() const;
+		void close();
+
+		bool send(const endpoint& to, const std::uint8_t* data, std::size_t size);
+		/**  the size of the datagram read, 0 if nothing was waiting */
+		std::size_t receive(std::uint8_t* buffer, std::size_t size, endpoint& from);
+	private:
+		std::intptr_t handle_ = -1;
+	};
+}
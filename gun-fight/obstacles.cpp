@@ -6,6 +6,10 @@
  * \date   February 2025
  *********************************************************************/
 #include "entities.h"
+#include "profiler.h"
+#include "collision.h"
+#include "events.h"
+#include "deferred.h"
 bool entities::obstacle::operator==(const entities::entity& other) {
 	return true;
 }
@@ -23,9 +27,10 @@ int entities::obstacle::get_health() {
 
 bool entities::obstacle::update(std::vector<std::shared_ptr<entity>>& entities) {
 	//TODO implement
-	// do a health check
-	if (health_ <= 0) {
+	// do a health check, the destruction is published once, the frame it happens
+	if (health_ <= 0 and not remove_) {
 		remove_ = true;
+		deferred::publish({ events::kind::OBSTACLE_DESTROYED, 0, archetype_, position_ });
 	}
 	return health_ > 0;
 }
@@ -65,16 +70,15 @@ bool entities::moveable_obstacle::move(std::vector<std::shared_ptr<entity>>& ent
 	proposed_rect.y = new_pos.y;
 
 	// TODO:: check players and entities
+	PROFILE_ZONE("collisions");
 	bool blocked = false;
-	std::for_each(entities.begin(), entities.end(), [this, &blocked, &proposed_rect](std::shared_ptr<entities::entity>& e)
-		{
-			if (this != e.get() and CheckCollisionRecs(proposed_rect, e->get_rectangle())) {
-				// if collide is false then do not move
-				if (not this->collide(*e)) {
-					blocked = true;
-				}
-			}
-		});
+	collision::for_each_overlap(entities, proposed_rect, [this, &blocked](entities::entity& e) {
+		// if collide is false then do not move
+		if (this != &e and not collide(e)) {
+			blocked = true;
+		}
+		return true;
+	});
 
 	if (blocked) {
 		change_direction();
@@ -107,16 +111,15 @@ bool entities::tumbleweed::move(std::vector<std::shared_ptr<entity>>& entities)
 	proposed_rect.y = new_pos.y;
 
 	// Check if any obstacle interrupts at the new position
+	PROFILE_ZONE("collisions");
 	bool blocked = false;
-	std::for_each(entities.begin(), entities.end(), [this, &blocked, &proposed_rect](std::shared_ptr<entities::entity>& e)
-		{
-			if (this != e.get() and CheckCollisionRecs(proposed_rect, e->get_rectangle())) {
-				// if collide is false then do not move
-				if (not this->collide(*e)) {
-					blocked = true;
-				}
-			}
-		});
+	collision::for_each_overlap(entities, proposed_rect, [this, &blocked](entities::entity& e) {
+		// if collide is false then do not move
+		if (this != &e and not collide(e)) {
+			blocked = true;
+		}
+		return true;
+	});
 
 	if (blocked) {
 		change_direction();
@@ -134,29 +137,27 @@ bool entities::tumbleweed::move(std::vector<std::shared_ptr<entity>>& entities)
 }
 
 bool entities::tumbleweed::update(std::vector<std::shared_ptr<entity>>& entities) {
-	// checks if alive, then moves 
-	entities::moveable_obstacle::update(entities);
+	// checks if alive, then moves. tumbleweed is final so move is not a virtual call
+	if (obstacle::update(entities)) {
+		move(entities);
+		++frames_existed_;
+	}
+	/**  switch to the final animation as the lifespan runs out */
+	if (frames_existed_ == lifespan_ - archetype::TUMBLEWEED.animation_length) {
+		animation_.next_animation();
+	}
 	if (frames_existed_ >= lifespan_) {
 		remove_ = true;
 	}
 	return true;
 }
 
-void entities::tumbleweed::draw() {
-	// update the frame and maybe animation
-	animation_.next_frame();
-	if (animation_.get_frame_num() == static_cast<int>(config::TUMBLEWEED_ANIMATION_LENGTH)) {
-		animation_.reset_animation();
-	}
-	if (frames_existed_ == lifespan_ - config::TUMBLEWEED_ANIMATION_LENGTH) {
-		animation_.next_animation();
-	}
-	entities::entity::draw();
-}
-
-void entities::wagon::draw() {
-	animation_.draw_frame(position_);
-	animation_.next_frame_loop();
+/**  same as the moveable obstacle update, repeated so the move call is resolved at compile time */
+bool entities::wagon::update(std::vector<std::shared_ptr<entity>>& entities) {
+	if (not obstacle::update(entities)) { return false; }
+	move(entities);
+	++frames_existed_;
+	return true;
 }
 
 void entities::wagon::change_direction() {
@@ -164,12 +165,11 @@ void entities::wagon::change_direction() {
 	position_.y += movement_speed_.y;
 	// moving down
 	if (movement_speed_.y > 0) {
-		animation_ = animation(config::WAGON_DOWN_PATH, config::WAGON_DOWN_WIDTH, config::WAGON_DOWN_HEIGHT, config::WAGON_ANIMATION_LENGTH, config::WAGON_ANIMATIONS);
+		animation_ = down_;
 	}
 	// moveing up
 	else if (movement_speed_.y < 0) {
-		animation_ = animation(config::WAGON_UP_PATH, config::WAGON_UP_WIDTH, config::WAGON_UP_HEIGHT, config::WAGON_ANIMATION_LENGTH, config::WAGON_ANIMATIONS);
-
+		animation_ = up_;
 	}
 }
 void entities::cactus::take_damage(int damage) {
@@ -0,0 +1,193 @@
+/*****************************************************************//**
+ * \file   particles.cpp
+ * \brief  implementation file for particle effects
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "particles.h"
+#include "profiler.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+	/**  how each effect's particles start */
+	struct style {
+		int count;
+		float speed_min;
+		float speed_max;
+		float spread; // radians either side of the direction, ignored when spraying all around
+		float life_min;
+		float life_max;
+		float size_min;
+		float size_max;
+		float gravity; // pixels per second squared
+	};
+
+	constexpr style STYLES[] = {
+		/* MUZZLE_FLASH */ { 14, 250.0f, 650.0f, 0.35f, 0.05f, 0.15f, 2.0f, 5.0f, 0.0f },
+		/* IMPACT */       { 10, 80.0f, 280.0f, 0.0f, 0.2f, 0.4f, 2.0f, 4.0f, config::PARTICLE_GRAVITY },
+		/* DEBRIS */       { 48, 120.0f, 480.0f, 0.0f, 0.4f, 0.9f, 3.0f, 7.0f, config::PARTICLE_GRAVITY },
+		/* BLOOD */        { 60, 60.0f, 320.0f, 0.0f, 0.4f, 1.0f, 2.0f, 5.0f, config::PARTICLE_GRAVITY },
+		/* EXPLOSION */    { 160, 100.0f, 700.0f, 0.0f, 0.3f, 1.0f, 3.0f, 9.0f, config::PARTICLE_GRAVITY * 0.25f },
+		/* DUST */         { 1, 10.0f, 40.0f, 0.0f, 0.4f, 0.8f, 3.0f, 6.0f, -40.0f }
+	};
+
+	constexpr Color FLASH = { 255, 210, 90, 255 };
+	constexpr Color BLOOD_RED = { 150, 20, 20, 255 };
+	constexpr Color FIRE = { 255, 150, 40, 255 };
+
+	/**  the debris colour of each obstacle */
+	Color colour_of(const archetype::descriptor* type) {
+		if (type == &archetype::TUMBLEWEED) { return Color{ 196, 160, 100, 255 }; }
+		if (type == &archetype::CACTUS) { return Color{ 70, 130, 60, 255 }; }
+		if (type == &archetype::BARREL) { return Color{ 120, 80, 40, 255 }; }
+		if (type == &archetype::WAGON) { return Color{ 140, 100, 60, 255 }; }
+		if (type == &archetype::STRAWMAN) { return Color{ 220, 190, 90, 255 }; }
+		return GRAY;
+	}
+
+	/**  events give the top left of the entity, the gunmen's bursts come from their middle */
+	Vector2 gunman_centre(Vector2 position) {
+		return Vector2{ position.x + config::GUNMAN_WIDTH / 2, position.y + config::GUNMAN_HEIGHT / 2 };
+	}
+}
+
+particles::pool::pool()
+	: x_(config::PARTICLE_CAPACITY), y_(config::PARTICLE_CAPACITY), vx_(config::PARTICLE_CAPACITY), vy_(config::PARTICLE_CAPACITY),
+	gravity_(config::PARTICLE_CAPACITY), life_(config::PARTICLE_CAPACITY), fade_(config::PARTICLE_CAPACITY),
+	size_(config::PARTICLE_CAPACITY), colour_(config::PARTICLE_CAPACITY) {
+}
+
+float particles::pool::random(float min, float max){
+	return std::uniform_real_distribution<float>(min, max)(random_);
+}
+
+void particles::pool::emit(effect type, Vector2 position, Color colour, float direction){
+	auto& s = STYLES[static_cast<int>(type)];
+	for (auto i = 0; i < s.count; ++i) {
+		if (count_ == config::PARTICLE_CAPACITY) {
+			dropped_ += s.count - i;
+			return;
+		}
+		auto angle = direction == 0.0f ? random(-std::numbers::pi_v<float>, std::numbers::pi_v<float>)
+			: (direction > 0.0f ? 0.0f : std::numbers::pi_v<float>) + random(-s.spread, s.spread);
+		auto speed = random(s.speed_min, s.speed_max);
+		auto life = random(s.life_min, s.life_max);
+		auto shade = random(0.75f, 1.0f);
+		x_[count_] = position.x;
+		y_[count_] = position.y;
+		vx_[count_] = std::cos(angle) * speed;
+		vy_[count_] = std::sin(angle) * speed;
+		gravity_[count_] = s.gravity;
+		life_[count_] = life;
+		fade_[count_] = 1.0f / life;
+		size_[count_] = random(s.size_min, s.size_max);
+		colour_[count_] = Color{ static_cast<unsigned char>(colour.r * shade), static_cast<unsigned char>(colour.g * shade),
+			static_cast<unsigned char>(colour.b * shade), colour.a };
+		++count_;
+	}
+}
+
+/**  player 1 faces right, so their shots spray to the right */
+void particles::pool::emit(const events::event& e){
+	switch (e.type) {
+	case events::kind::SHOT:
+		emit(effect::MUZZLE_FLASH, e.position, FLASH, e.player == 1 ? 1.0f : -1.0f);
+		break;
+	case events::kind::HIT:
+		if (e.target == nullptr) {
+			emit(effect::BLOOD, e.position, BLOOD_RED);
+		}
+		else {
+			emit(effect::IMPACT, e.position, colour_of(e.target));
+		}
+		break;
+	case events::kind::OBSTACLE_DESTROYED:
+		emit(effect::DEBRIS, Vector2{ e.position.x + e.target->width / 2, e.position.y + e.target->height / 2 }, colour_of(e.target));
+		break;
+	case events::kind::DEATH:
+		emit(effect::BLOOD, gunman_centre(e.position), BLOOD_RED);
+		break;
+	case events::kind::EXPLOSION:
+		emit(effect::EXPLOSION, e.position, FIRE);
+		emit(effect::DEBRIS, e.position, DARKGRAY);
+		break;
+	default:
+		break;
+	}
+}
+
+/**  one pass over the arrays with no branches or calls, so it vectorises. The drag is
+ * worked out once for the frame instead of per particle */
+void particles::pool::update(float dt){
+	PROFILE_ZONE("particles");
+	auto drag = std::pow(config::PARTICLE_DRAG, dt * config::TARGET_FPS);
+	float* __restrict x = x_.data();
+	float* __restrict y = y_.data();
+	float* __restrict vx = vx_.data();
+	float* __restrict vy = vy_.data();
+	float* __restrict life = life_.data();
+	const float* __restrict gravity = gravity_.data();
+	auto n = count_;
+	for (std::size_t i = 0; i < n; ++i) {
+		vx[i] *= drag;
+		vy[i] = vy[i] * drag + gravity[i] * dt;
+		x[i] += vx[i] * dt;
+		y[i] += vy[i] * dt;
+		life[i] -= dt;
+	}
+
+	/**  fill each expired slot with the last live particle, the draw order does not matter */
+	for (std::size_t i = 0; i < count_;) {
+		if (life[i] > 0.0f) {
+			++i;
+			continue;
+		}
+		--count_;
+		x[i] = x[count_];
+		y[i] = y[count_];
+		vx[i] = vx[count_];
+		vy[i] = vy[count_];
+		life[i] = life[count_];
+		gravity_[i] = gravity_[count_];
+		fade_[i] = fade_[count_];
+		size_[i] = size_[count_];
+		colour_[i] = colour_[count_];
+	}
+}
+
+/**  untextured quads on the default texture, the same way raylib draws rectangles.
+ * rlgl draws and restarts the batch by itself if it fills */
+void particles::pool::draw() const {
+	if (count_ == 0) { return; }
+	PROFILE_ZONE("draw_particles");
+	rlSetTexture(rlGetTextureIdDefault());
+	rlBegin(RL_QUADS);
+	for (std::size_t i = 0; i < count_; ++i) {
+		auto& c = colour_[i];
+		auto alpha = std::min(life_[i] * fade_[i], 1.0f) * c.a;
+		rlColor4ub(c.r, c.g, c.b, static_cast<unsigned char>(alpha));
+		auto half = size_[i] / 2;
+		rlVertex2f(x_[i] - half, y_[i] - half);
+		rlVertex2f(x_[i] - half, y_[i] + half);
+		rlVertex2f(x_[i] + half, y_[i] + half);
+		rlVertex2f(x_[i] + half, y_[i] - half);
+	}
+	rlEnd();
+	rlSetTexture(0);
+}
+
+void particles::pool::clear(){
+	count_ = 0;
+}
+
+std::size_t particles::pool::size() const {
+	return count_;
+}
+
+particles::pool_stats particles::pool::get_stats() const {
+	return pool_stats{ count_, dropped_ };
+}
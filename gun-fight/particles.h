@@ -0,0 +1,78 @@
+/*****************************************************************//**
+ * \file   particles.h
+ * \brief  header file for particle effects: muzzle flashes, bullet impacts,
+ * debris from destroyed obstacles, blood, explosions and tumbleweed dust.
+ *
+ * Particles live in a fixed capacity pool laid out as a structure of arrays,
+ * one array per attribute, so the update is a single pass of straight line
+ * float arithmetic the compiler can vectorise. Dead particles are replaced by
+ * the last live one, so the live particles stay packed at the front. Nothing
+ * is allocated after construction, a full pool drops new particles.
+ *
+ * The effects are cosmetic. They are emitted from the gameplay events when
+ * they are presented, never from the simulation, and use their own random
+ * numbers so they cannot change the outcome of a game. Every particle is one
+ * untextured quad and the pool is drawn in a single batch
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "events.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace particles {
+	enum class effect : std::uint8_t {
+		MUZZLE_FLASH,
+		IMPACT, // a bullet hitting an obstacle
+		DEBRIS, // an obstacle destroyed
+		BLOOD,
+		EXPLOSION,
+		DUST
+	};
+
+	struct pool_stats {
+		std::size_t live = 0;
+		std::size_t dropped = 0; // particles not emitted because the pool was full
+	};
+
+	class pool {
+	public:
+		/**  constructors and destructors */
+		~pool() = default;
+		pool();
+		pool(const pool&) = delete;
+		pool& operator=(const pool&) = delete;
+
+		/**  a burst of one effect, direction is 1 or -1 to spray one way and 0 for all around */
+		void emit(effect type, Vector2 position, Color colour, float direction = 0.0f);
+		/**  the burst that goes with a gameplay event, if any */
+		void emit(const events::event& e);
+		/**  move every particle by the elapsed time and remove the expired ones */
+		void update(float dt);
+		/**  all live particles in one batch of quads */
+		void draw() const;
+		void clear();
+		std::size_t size() const;
+		pool_stats get_stats() const;
+	private:
+		float random(float min, float max);
+
+		/**  one array per attribute, all config::PARTICLE_CAPACITY long */
+		std::vector<float> x_;
+		std::vector<float> y_;
+		std::vector<float> vx_;
+		std::vector<float> vy_;
+		std::vector<float> gravity_;
+		std::vector<float> life_; // seconds left
+		std::vector<float> fade_; // one over the starting life, the alpha is life * fade
+		std::vector<float> size_;
+		std::vector<Color> colour_;
+		std::size_t count_ = 0;
+		std::size_t dropped_ = 0;
+		std::minstd_rand random_{ 1 }; // apart from the game's generator, so effects never change the play
+	};
+}
@@ -6,28 +6,8 @@
  * \date   February 2025
  *********************************************************************/
 #include "entities.h"
+#include "arena.h"
 
-/** state function implementation */
-std::unique_ptr<entities::pickup::pickup_state> entities::pickup::on_ground::clone() {
-	//TODO implement
-	return std::make_unique<entities::pickup::on_ground>(*this);
-}
-std::unique_ptr<entities::pickup::pickup_state> entities::pickup::in_inventory::clone() {
-	// TODO implement
-	return std::make_unique<entities::pickup::in_inventory>(*this);
-}
-
-bool entities::pickup::on_ground::update(entities::pickup* p) {
-	// TODO implement
-	// do nothing so far
-	return true;
-}
-
-bool entities::pickup::in_inventory::update(entities::pickup* p) {
-	//TODO implement
-	// check if aa key was pressed
-	return true; // whether the item should be kept in the inventory or not
-}
 bool entities::pickup::operator==(const entities::entity& other) {
 	return true;
 }
@@ -44,11 +24,24 @@ void entities::pickup::draw(float x, float y) {
 	auto pos = Vector2{ x, y };
 	animation_.draw_frame(pos);
 }
+int entities::pickup::get_layer() const {
+	return render::GROUND;
+}
+void entities::pickup::pick_up() {
+	state_ = pickup_state::IN_INVENTORY;
+}
+entities::pickup::pickup_state entities::pickup::get_state() const {
+	return state_;
+}
 
 /** empty pickup use */
 void entities::empty_pickup::use(std::shared_ptr<gunman>& gunman, std::shared_ptr<weapon>& weapon, std::vector<std::shared_ptr<entity>>& entities) {
 	return;
 }
+const std::shared_ptr<entities::pickup>& entities::empty_pickup::sentinel() {
+	static const auto empty = std::shared_ptr<pickup>(std::make_shared<empty_pickup>(0.0, 0.0, config::DEFAULT_PATH));
+	return empty;
+}
 
 /** increase player health to a max of two */
 void entities::health_pickup::use(std::shared_ptr<gunman>& gunman, std::shared_ptr<weapon>& weapon, std::vector<std::shared_ptr<entity>>& entities) {
@@ -59,19 +52,20 @@ void entities::health_pickup::use(std::shared_ptr<gunman>& gunman, std::shared_p
 void entities::rifle_pickup::use(std::shared_ptr<gunman>& gunman, std::shared_ptr<weapon>& weapon, std::vector<std::shared_ptr<entity>>& entities) {
 	// replace the weapon and the gunman animation
 	// first check if the weapon is a rifle, do nothing if they already hav e rifle
-	weapon = std::make_shared<entities::rifle>(entities::rifle(weapon->get_x(), weapon->get_y(), config::RIFLE_PATH));
+	weapon = memory::make_round<entities::rifle>(entities::rifle(weapon->get_x(), weapon->get_y(), config::RIFLE_PATH));
 	if (gunman->get_direction() == 1) {
-		gunman->set_animation(animation(config::P1_RIFLE_PATH, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS));
+		gunman->set_animation(animation(config::P1_RIFLE_PATH, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS, config::GUNMAN_FRAME_TIME));
 	}
 	else {
-		gunman->set_animation(animation(config::P2_RIFLE_PATH, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS));
+		gunman->set_animation(animation(config::P2_RIFLE_PATH, config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT, config::GUNMAN_ANIMAITON_LENGTH, config::GUNMAN_ANIMATIONS, config::GUNMAN_FRAME_TIME));
 	}
 
 	return;
 }
 
-/**  change the player's weapon to dynamite */
+/**  change the player's weapon to dynamite, the gunman keeps the pose they have */
 void entities::dynamite_pickup::use(std::shared_ptr<gunman>& gunman, std::shared_ptr<weapon>& weapon, std::vector<std::shared_ptr<entity>>& entities) {
+	weapon = memory::make_round<entities::dynamite>(entities::dynamite(weapon->get_x(), weapon->get_y(), config::DYNAMITE_PATH));
 	return;
 }
 
@@ -92,13 +86,13 @@ void entities::strawman_pickup::use(std::shared_ptr<gunman>& gunman, std::shared
 	// left facing gunman
 	if (gunman->get_direction() == 1) {
 		float x = gunman->get_x() + (gunman->get_animation().get_frame_width() * 1.5);
-		entities.push_back(std::make_shared<entities::strawman>(strawman(x, gunman->get_y(), config::STRAWMAN_LEFT_PATH, gunman->get_direction())));
+		entities.push_back(memory::make_round<entities::strawman>(strawman(x, gunman->get_y(), config::STRAWMAN_LEFT_PATH, gunman->get_direction())));
 	}
 
 	// right facing gunman
 	else {
 		float x = gunman->get_x() - (gunman->get_animation().get_frame_width() * 1.5);
-		entities.push_back(std::make_shared<entities::strawman>(strawman(x, gunman->get_y(), config::STRAWMAN_RIGHT_PATH, gunman->get_direction())));
+		entities.push_back(memory::make_round<entities::strawman>(strawman(x, gunman->get_y(), config::STRAWMAN_RIGHT_PATH, gunman->get_direction())));
 	}
 	return;
 }
@@ -1,4 +1,6 @@
 #include "player.h"
+#include "profiler.h"
+#include "events.h"
 
 player& player::operator=(const player& other){
 	gunman_ = other.gunman_;
@@ -11,6 +13,19 @@ player& player::operator=(const player& other){
 	return *this;
 }
 
+player player::create(int number){
+	auto first = number == 1;
+	auto gunman = std::make_shared<entities::gunman>(entities::gunman(first ? config::P1_START_X : config::P2_START_X,
+		first ? config::P1_START_Y : config::P2_START_Y, first ? config::P1_PATH : config::P2_PATH, 1, first ? 1 : -1));
+	auto gunamn_centre_x = gunman->get_x() + config::GUNMAN_WIDTH / 2;
+	auto weapon_x = gunamn_centre_x + ((config::GUNMAN_WIDTH / 2) + archetype::BULLET.width) * gunman->get_direction();
+	auto weapon = std::make_shared<entities::revolver>(entities::revolver(weapon_x, gunman->get_y() + 45, config::REVOLVER_PATH));
+	if (first) {
+		return player(gunman, weapon, config::GUNMAN1_MOVEMENT, config::GUNMAN1_FIRING, config::P1_ITEM_KEY, 150, config::P1_WIN_PATH);
+	}
+	return player(gunman, weapon, config::GUNMAN2_MOVEMENT, config::GUNMAN2_FIRING, config::P2_ITEM_KEY, config::SCREEN_WIDTH - 150, config::P2_WIN_PATH);
+}
+
 std::shared_ptr<entities::gunman> player::get_gunman(){
 	return gunman_;
 }
@@ -24,15 +39,15 @@ std::shared_ptr<entities::pickup> player::get_item(){
 }
 
 // pass in the entities list
-bool player::update_player(std::vector<std::shared_ptr<entities::entity>>& entities) {
+bool player::update_player(std::vector<std::shared_ptr<entities::entity>>& entities, const input::input_queue& input) {
 	gunman_->update(entities);
 	weapon_->update(entities);
 	item_->update(entities);
 	// here is where you check for player movement and player firing
 
 	// check gunman movement
-	std::for_each(movement_.begin(), movement_.end(), [this, &entities](auto& key_direction) {
-	if (IsKeyDown(key_direction.first)) {
+	std::for_each(movement_.begin(), movement_.end(), [this, &entities, &input](auto& key_direction) {
+	if (input.held(key_direction.first)) {
 		if (gunman_->move(key_direction.second, entities)) {
 			auto gunamn_centre_x = gunman_->get_x() + config::GUNMAN_WIDTH / 2;
 			auto weapon_x = gunamn_centre_x + ((config::GUNMAN_WIDTH / 2) + 5) * gunman_->get_direction();
@@ -42,98 +57,142 @@ bool player::update_player(std::vector<std::shared_ptr<entities::entity>>& entit
 		}
 		return false; // no movement key was pressed
 	});
-	// check weapon firing 
+	// check weapon firing, dynamite is thrown instead
 	if (weapon_->get_cooldown() > 0) { weapon_->decrement_cooldown(); }
 
-	if (IsKeyPressed(fire_reload_.first) and std::none_of(movement_.begin(), movement_.end(), [](auto& key_direction) {
-		return IsKeyDown(key_direction.first); })) {
+	if (auto dynamite = dynamic_cast<entities::dynamite*>(weapon_.get()); dynamite != nullptr) {
+		throw_dynamite(*dynamite, entities, input);
+	}
+	else if (input.pressed(fire_reload_.first) and std::none_of(movement_.begin(), movement_.end(), [&input](auto& key_direction) {
+		return input.held(key_direction.first); })) {
 		if (weapon_->fire()) {
 			// calculate the offset as distance from the centre of the gunman
-			entities.push_back(std::move(weapon_->create_bullet(weapon_->get_x(), weapon_->get_y(), gunman_->get_direction())));
+			auto bullet = weapon_->create_bullet(weapon_->get_x(), weapon_->get_y(), gunman_->get_direction());
+			events::publish({ events::kind::SHOT, get_id(), bullet->get_archetype(), weapon_->get_position() });
+			// the shot was fired part way through the frame, so it has already travelled a little
+			bullet->lead(input.get_lead(fire_reload_.first));
+			entities.push_back(std::move(bullet));
 		}
 	}
-	if (IsKeyPressed(fire_reload_.second)) {
+	if (input.pressed(fire_reload_.second)) {
 		weapon_->reload();
+		events::publish({ events::kind::RELOAD, get_id(), nullptr, weapon_->get_position() });
 	}
 	// check if gunman is colliding with an item, then pick it up
 	pickup_item(entities);
 
 	// check if an item is used
-	if (IsKeyPressed(item_use_)) {
+	if (input.pressed(item_use_)) {
 		// use the item
+		if (item_ != entities::empty_pickup::sentinel()) {
+			events::publish({ events::kind::ITEM_USED, get_id(), nullptr, gunman_->get_position() });
+		}
 		item_->use(gunman_, weapon_, entities);
 		// remove the item from the slot 
-		item_ = std::make_shared<entities::empty_pickup>(entities::empty_pickup(0.0, 0.0, config::DEFAULT_PATH));
+		item_ = entities::empty_pickup::sentinel();
 	}
 	return true;
 }
 
+double player::get_fire_time(const input::input_queue& input){
+	return input.press_time(fire_reload_.first);
+}
+
+/**  charge while the fire key is held and throw when it is let go, dynamite can be thrown on the move */
+void player::throw_dynamite(entities::dynamite& dynamite, std::vector<std::shared_ptr<entities::entity>>& entities, const input::input_queue& input){
+	if ((input.held(fire_reload_.first) or input.pressed(fire_reload_.first)) and dynamite.can_charge()) {
+		dynamite.charge();
+		return;
+	}
+	if (dynamite.is_charging() and dynamite.fire()) {
+		events::publish({ events::kind::SHOT, get_id(), &archetype::DYNAMITE_STICK, dynamite.get_position() });
+		entities.push_back(dynamite.create_bullet(dynamite.get_x(), dynamite.get_y(), gunman_->get_direction()));
+	}
+}
+
 void player::pickup_item(std::vector<std::shared_ptr<entities::entity>>& entities) {
 	// check gunman collision with items
+	PROFILE_ZONE("collisions");
 	for (auto& e : entities) {
 		auto pickup = dynamic_cast<entities::pickup*>(e.get());
 		if (pickup != nullptr and CheckCollisionRecs(e->get_rectangle(), gunman_->get_rectangle())) {
 			e->set_remove(true);
-			item_ = std::dynamic_pointer_cast<entities::pickup>(e);
+			item_ = std::static_pointer_cast<entities::pickup>(e);
+			item_->pick_up();
 		}
 	}
 }
-void player::draw_player(){
-	// draw gunman
-	gunman_->draw();
-	// draw weapon hud
-	if (gunman_->get_direction() == -1) {
-		float x = config::SCREEN_WIDTH - 115 - weapon_->get_animation().get_frame_width() - 210;
-		weapon_->draw(x, config::SCREEN_HEIGHT - 185);
-		// draw hearts
-		x += weapon_->get_animation().get_frame_width() + 5;
-		auto heart_pos = Vector2{x, config::SCREEN_HEIGHT - 185};
-		// draw hearts
-		for (auto i = 0; i < gunman_->get_health(); ++i) {
-			heart_.draw_frame(heart_pos);
-			heart_pos.x += config::HEART_WIDTH + config::HEART_SPACING;
-		}
-		// draw armour 
-		for (auto i = 0; i < gunman_->get_armour(); ++i) {
-			armour_.draw_frame(heart_pos);
-			heart_pos.x += config::HEART_WIDTH + config::HEART_SPACING;
-		
-		}
-		// draw item hud, underneath the heart
-		x += item_->get_animation().get_frame_width();
-		auto y = heart_pos.y + (item_->get_animation().get_frame_height() * 1.5);
-		item_->draw(x, y);
+void player::draw_player(render::render_queue& queue){
+	// draw gunman, and where their dynamite will land while a throw is charged
+	gunman_->draw(queue);
+	if (auto dynamite = dynamic_cast<entities::dynamite*>(weapon_.get()); dynamite != nullptr) {
+		dynamite->draw_marker(queue, gunman_->get_direction());
+	}
+}
 
+/**  the hud's values and sprites as they are now, an empty weapon shows its last frame */
+render::player_view player::get_view(){
+	auto view = render::player_view{ get_hud_state(), weapon_->get_animation(), item_->get_animation() };
+	if (weapon_->is_empty()) {
+		view.weapon.end_frame();
+	}
+	return view;
+}
 
+void player::draw_hud(const render::player_view& view, render::render_queue& queue){
+	// re-render the hud panel only if something it shows has changed
+	if (not hud_.is_rendered() or not (view.hud == drawn_hud_)) {
+		hud_.begin_render();
+		render_hud(view);
+		hud_.end_render();
+		drawn_hud_ = view.hud;
 	}
-	else {
-		float x = 115;
-		weapon_->draw(x, config::SCREEN_HEIGHT - 185);
-		x += weapon_->get_animation().get_frame_width() + 5;
-		auto heart_pos = Vector2{x, config::SCREEN_HEIGHT - 185};
-		// draw hearts
-		for (auto i = 0; i < gunman_->get_health(); ++i) {
-			heart_.draw_frame(heart_pos);
-			heart_pos.x += config::HEART_WIDTH + config::HEART_SPACING;
-		}
-		// draw armour 
-		for (auto i = 0; i < gunman_->get_armour(); ++i) {
-			armour_.draw_frame(heart_pos);
-			heart_pos.x += config::HEART_WIDTH + config::HEART_SPACING;
-		
-		}
+	hud_.draw(queue);
+}
 
-		// draw item hud, underneath the heart
-		x += item_->get_animation().get_frame_width();
-		auto y = heart_pos.y + (item_->get_animation().get_frame_height() * 1.5);
-		item_->draw(x, y);
+/**  draw the weapon, hearts, armour and item, relative to the hud panel origin */
+void player::render_hud(const render::player_view& view){
+	// draw weapon hud
+	auto weapon = view.weapon;
+	auto pos = Vector2{ 0.0, 0.0 };
+	weapon.draw_frame(pos);
+	float x = weapon.get_frame_width() + 5;
+	auto heart_pos = Vector2{x, 0.0};
+	// draw hearts
+	for (auto i = 0; i < view.hud.health; ++i) {
+		heart_.draw_frame(heart_pos);
+		heart_pos.x += config::HEART_WIDTH + config::HEART_SPACING;
 	}
+	// draw armour 
+	for (auto i = 0; i < view.hud.armour; ++i) {
+		armour_.draw_frame(heart_pos);
+		heart_pos.x += config::HEART_WIDTH + config::HEART_SPACING;
+	}
+	// draw item hud, underneath the heart
+	auto item = view.item;
+	x += item.get_frame_width();
+	auto item_pos = Vector2{ x, static_cast<float>(heart_pos.y + (item.get_frame_height() * 1.5)) };
+	item.draw_frame(item_pos);
 }
 
-void player::draw_win(){
+hud_state player::get_hud_state(){
+	auto weapon_frame = weapon_->get_animation().get_current_frame();
+	return hud_state{
+		gunman_->get_health(),
+		gunman_->get_armour(),
+		weapon_->get_ammo(),
+		weapon_->is_empty(),
+		weapon_->get_animation().get_sheet().id,
+		weapon_frame.x,
+		weapon_frame.y,
+		item_->get_path()
+	};
+}
+
+void player::draw_win(render::render_queue& queue){
 	// make it last 10 frames
 	auto win_pos = Vector2{ config::SCREEN_WIDTH_HALF - (config::WIN_WIDTH / 2), config::SCREEN_HEIGHT_HALF - (config::WIN_HEIGHT / 2) };
-	win_.draw_frame(win_pos);
+	win_.queue_frame(queue, win_pos, render::OVERLAY, 0.0);
 }
 
 void player::increase_score(){
@@ -141,25 +200,31 @@ void player::increase_score(){
 }
 
 bool player::is_dead(){
-	if (gunman_->get_health() <= 0) {
-		// change anim, check the position
-		if (gunman_->get_direction() == 1) {
-			auto y = gunman_->get_y() + gunman_->get_animation().get_frame_height();
-			gunman_->set_animation(animation(config::P1_DEAD_PATH, config::GUNMAN_DEAD_WIDTH, config::GUNMAN_DEAD_HEIGHT));
-			gunman_->set_pos(gunman_->get_x(), gunman_->get_y());
-		}
-		else{
-			gunman_->set_animation(animation(config::P2_DEAD_PATH, config::GUNMAN_DEAD_WIDTH, config::GUNMAN_DEAD_HEIGHT));
-			auto x = gunman_->get_x();
-			auto y = gunman_->get_y() + gunman_->get_animation().get_frame_height();
-			gunman_->set_pos(gunman_->get_x(), y);
-			if (x + gunman_->get_animation().get_frame_width() > config::SCREEN_WIDTH) {
-				gunman_->set_pos(config::SCREEN_WIDTH - gunman_->get_animation().get_frame_width(), gunman_->get_y());
-			}
+	return gunman_->get_health() <= 0;
+}
+
+/**  swap to the dead pose, called by the presentation once the death has been published */
+void player::show_death(){
+	// change anim, check the position
+	if (gunman_->get_direction() == 1) {
+		auto y = gunman_->get_y() + gunman_->get_animation().get_frame_height();
+		gunman_->set_animation(animation(config::P1_DEAD_PATH, config::GUNMAN_DEAD_WIDTH, config::GUNMAN_DEAD_HEIGHT));
+		gunman_->set_pos(gunman_->get_x(), gunman_->get_y());
+	}
+	else{
+		gunman_->set_animation(animation(config::P2_DEAD_PATH, config::GUNMAN_DEAD_WIDTH, config::GUNMAN_DEAD_HEIGHT));
+		auto x = gunman_->get_x();
+		auto y = gunman_->get_y() + gunman_->get_animation().get_frame_height();
+		gunman_->set_pos(gunman_->get_x(), y);
+		if (x + gunman_->get_animation().get_frame_width() > config::SCREEN_WIDTH) {
+			gunman_->set_pos(config::SCREEN_WIDTH - gunman_->get_animation().get_frame_width(), gunman_->get_y());
 		}
-		return true;
 	}
-	return false;
+}
+
+/**  player 1 faces right */
+std::uint8_t player::get_id(){
+	return gunman_->get_direction() == 1 ? 1 : 2;
 }
 
 void player::reset_player(){
@@ -172,11 +237,11 @@ void player::reset_player(){
 	
 	// reset the gun position
 	auto gunamn_centre_x = gunman_->get_x() + config::GUNMAN_WIDTH / 2;
-	auto weapon_x = gunamn_centre_x + ((config::GUNMAN_WIDTH / 2) + config::BULLET_WIDTH) * gunman_->get_direction();
+	auto weapon_x = gunamn_centre_x + ((config::GUNMAN_WIDTH / 2) + archetype::BULLET.width) * gunman_->get_direction();
 	weapon_->set_pos(weapon_x, gunman_->get_y() + 45);
 
 	// reset the item to a clear one
-	item_ = std::make_shared<entities::empty_pickup>(entities::empty_pickup(0.0, 0.0, config::DEFAULT_PATH));
+	item_ = entities::empty_pickup::sentinel();
 }
 
 int player::get_score(){
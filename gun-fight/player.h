@@ -1,24 +1,32 @@
 #pragma once
 #include "entities.h"
+#include "hud.h"
+#include "input.h"
+#include "snapshot.h"
+#include <cstdint>
 #include <tuple>
 class player{
 public:
 	~player() = default;
 	//TODO cant clone a nullptr
-	player(std::shared_ptr<entities::gunman> gunman, std::shared_ptr<entities::weapon> weapon, std::map<int, Vector2>& movement_keys, std::pair<int, int>& fire_reload_keys, int item_key, int  draw_x, const char* win_path)
+	player(std::shared_ptr<entities::gunman> gunman, std::shared_ptr<entities::weapon> weapon, const std::map<int, Vector2>& movement_keys, const std::pair<int, int>& fire_reload_keys, int item_key, int  draw_x, const char* win_path)
 		: gunman_(gunman), weapon_(std::move(weapon)),
-		item_(std::make_unique<entities::empty_pickup>(entities::empty_pickup(0.0,0.0, config::DEFAULT_PATH))), movement_(movement_keys), fire_reload_(fire_reload_keys), item_use_(item_key), score_(0), draw_x_(draw_x) {
+		item_(entities::empty_pickup::sentinel()), movement_(movement_keys), fire_reload_(fire_reload_keys), item_use_(item_key), score_(0), draw_x_(draw_x) {
 		player_start_pos_ = gunman_->get_position();
 		heart_ = animation(config::HEART_PATH, config::HEART_WIDTH, config::HEART_HEIGHT);
 		armour_ = animation(config::ARMOUR_PATH, config::HEART_WIDTH, config::HEART_HEIGHT);
 		win_ = animation(win_path, config::WIN_WIDTH, config::WIN_HEIGHT);
+		auto hud_x = gunman_->get_direction() == 1 ? config::P1_HUD_PANEL_X : config::P2_HUD_PANEL_X;
+		hud_ = hud_panel(hud_x, config::HUD_PANEL_Y, config::HUD_PANEL_WIDTH, config::HUD_PANEL_HEIGHT);
 	};
 	player(const player& other)
 		: gunman_(other.gunman_), weapon_(other.weapon_),
 		item_(other.item_), score_(other.score_), player_start_pos_(other.player_start_pos_),
-		movement_(other.movement_), fire_reload_(other.fire_reload_), item_use_(other.item_use_), draw_x_(other.draw_x_), heart_(other.heart_), armour_(other.armour_),win_(other.win_){};
+		movement_(other.movement_), fire_reload_(other.fire_reload_), item_use_(other.item_use_), draw_x_(other.draw_x_), heart_(other.heart_), armour_(other.armour_),win_(other.win_), hud_(other.hud_), drawn_hud_(other.drawn_hud_){};
 
 	player& operator=(const player& other);
+	/**  player 1 or 2 at their start position with a revolver, using their default keys */
+	static player create(int number);
 	// get player gunman
 	std::shared_ptr<entities::gunman> get_gunman();
 	// get player weapon
@@ -26,15 +34,23 @@ public:
 	// get player item
 	std::shared_ptr<entities::pickup> get_item();
 	// update player
-	bool update_player(std::vector<std::shared_ptr<entities::entity>>& entities);
+	bool update_player(std::vector<std::shared_ptr<entities::entity>>& entities, const input::input_queue& input);
+	double get_fire_time(const input::input_queue& input); // when the fire key was pressed this frame
+	void throw_dynamite(entities::dynamite& dynamite, std::vector<std::shared_ptr<entities::entity>>& entities, const input::input_queue& input);
 	void pickup_item(std::vector<std::shared_ptr<entities::entity>>& entities);
-	// draw player
-	void draw_player();
-	void draw_win();
+	// draw player, the gunman and dynamite marker are queued by the simulation
+	void draw_player(render::render_queue& queue);
+	render::player_view get_view();
+	hud_state get_hud_state();
+	/**  the hud panel, drawn on the render thread from the view recorded by the simulation */
+	void draw_hud(const render::player_view& view, render::render_queue& queue);
+	void draw_win(render::render_queue& queue);
 	// increase_score
 	void increase_score();
 	// is dead
 	bool is_dead();
+	void show_death();
+	std::uint8_t get_id(); // 1 or 2, as published in events
 	// player reset
 	void reset_player();
 
@@ -42,6 +58,7 @@ public:
 	void set_score(int score);
 	float get_draw_x();
 private:
+	void render_hud(const render::player_view& view);
 	
 	/** entity components */
 	std::shared_ptr<entities::gunman> gunman_;
@@ -54,13 +71,17 @@ private:
 	float draw_x_;
 	
 	/** player controls */
-	std::map<int, Vector2>& movement_;
-	std::pair<int, int>& fire_reload_;
+	std::map<int, Vector2> movement_;
+	std::pair<int, int> fire_reload_;
 	int item_use_;
 
 	/** animaations */
 	animation heart_;
 	animation armour_; 
 	animation win_;
+
+	/** cached hud, re-rendered only when the values it shows change. Only the render thread uses it */
+	hud_panel hud_;
+	hud_state drawn_hud_;
 };
 
@@ -0,0 +1,194 @@
+/*****************************************************************//**
+ * \file   profiler.cpp
+ * \brief  implementation file for the frame profiler
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "profiler.h"
+
+#ifdef GUNFIGHT_PROFILE
+#include "raylib.h"
+#include "config.h"
+#include "alloc_tracker.h"
+#include "audio.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace {
+	/**  per zone milliseconds, smoothed over recent frames */
+	struct zone_total {
+		const char* name;
+		int depth;
+		double ms;
+	};
+
+	struct profiler_state {
+		profiler_state() {
+			/**  reserved up front so recording zones does not allocate */
+			trace.reserve(config::PROFILER_MAX_EVENTS);
+			sorted.reserve(config::PROFILER_FRAME_HISTORY);
+		}
+		profiler::clock::time_point origin = profiler::clock::now();
+		profiler::clock::time_point frame_start = origin;
+		std::mutex mutex; // zones may close on any thread
+		std::vector<profiler::zone_event> trace; // kept for export, capped
+		std::vector<profiler::zone_event> frame; // closed since the frame began
+		std::vector<zone_total> totals;
+		std::vector<double> frame_times; // ring of recent frame times
+		std::vector<double> sorted; // scratch for the percentiles
+		std::size_t next_frame = 0;
+		std::size_t entity_count = 0;
+		bool overlay = false;
+	};
+
+	profiler_state& state() {
+		static profiler_state s;
+		return s;
+	}
+
+	/**  names of the zones open on this thread, innermost last */
+	thread_local std::vector<const char*> open_zones;
+
+	unsigned int thread_index() {
+		static std::atomic<unsigned int> next = 0;
+		thread_local unsigned int index = next++;
+		return index;
+	}
+
+	long long since_origin(profiler::clock::time_point t) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(t - state().origin).count();
+	}
+
+	double percentile(profiler_state& s, double p) {
+		if (s.frame_times.empty()) { return 0.0; }
+		s.sorted.assign(s.frame_times.begin(), s.frame_times.end());
+		auto n = static_cast<std::size_t>(p * (s.sorted.size() - 1));
+		std::nth_element(s.sorted.begin(), s.sorted.begin() + n, s.sorted.end());
+		return s.sorted[n];
+	}
+}
+
+profiler::zone::zone(const char* name)
+	: name_(name), start_(clock::now()), depth_(static_cast<int>(open_zones.size())) {
+	open_zones.push_back(name);
+}
+
+profiler::zone::~zone(){
+	auto end = clock::now();
+	open_zones.pop_back();
+	auto start = since_origin(start_);
+	auto event = zone_event{ name_, start, since_origin(end) - start, thread_index(), depth_ };
+	auto& s = state();
+	std::lock_guard lock(s.mutex);
+	s.frame.push_back(event);
+	if (s.trace.size() < config::PROFILER_MAX_EVENTS) {
+		s.trace.push_back(event);
+	}
+}
+
+void profiler::begin_frame(){
+	state().frame_start = clock::now();
+	alloc::begin_frame();
+}
+
+/**  fold the zones closed this frame into the per zone averages */
+void profiler::end_frame(std::size_t entity_count){
+	auto& s = state();
+	auto frame_ms = std::chrono::duration<double, std::milli>(clock::now() - s.frame_start).count();
+	alloc::end_frame();
+	std::lock_guard lock(s.mutex);
+	if (s.frame_times.size() < config::PROFILER_FRAME_HISTORY) {
+		s.frame_times.push_back(frame_ms);
+	}
+	else {
+		s.frame_times[s.next_frame] = frame_ms;
+	}
+	s.next_frame = (s.next_frame + 1) % config::PROFILER_FRAME_HISTORY;
+	s.entity_count = entity_count;
+
+	for (auto& total : s.totals) {
+		total.ms *= (1.0 - config::PROFILER_SMOOTHING);
+	}
+	for (auto& event : s.frame) {
+		auto it = std::find_if(s.totals.begin(), s.totals.end(), [&event](auto& total) {
+			return std::strcmp(total.name, event.name) == 0; });
+		if (it == s.totals.end()) {
+			s.totals.push_back(zone_total{ event.name, event.depth, 0.0 });
+			it = s.totals.end() - 1;
+		}
+		it->ms += (event.duration / 1000.0) * config::PROFILER_SMOOTHING;
+	}
+	s.frame.clear();
+}
+
+const char* profiler::current_zone(){
+	return open_zones.empty() ? nullptr : open_zones.back();
+}
+
+void profiler::toggle_overlay(){
+	state().overlay = not state().overlay;
+}
+
+void profiler::draw_overlay(){
+	auto& s = state();
+	if (not s.overlay) { return; }
+	std::lock_guard lock(s.mutex);
+	auto x = config::PROFILER_OVERLAY_X;
+	auto y = config::PROFILER_OVERLAY_Y;
+	auto line = config::PROFILER_FONT_SIZE + 2;
+	auto height = line * static_cast<int>(s.totals.size() + alloc::zone_count() + 6) + 10;
+	DrawRectangle(x - 5, y - 5, config::PROFILER_OVERLAY_WIDTH, height, Fade(BLACK, 0.7f));
+
+	DrawText(TextFormat("frame p50 %.2f  p95 %.2f  p99 %.2f ms", percentile(s, 0.5),
+		percentile(s, 0.95), percentile(s, 0.99)), x, y, config::PROFILER_FONT_SIZE, RAYWHITE);
+	y += line;
+	DrawText(TextFormat("entities %i  fps %i", static_cast<int>(s.entity_count), GetFPS()), x, y, config::PROFILER_FONT_SIZE, RAYWHITE);
+	y += line;
+	auto mix = audio::get_stats();
+	DrawText(TextFormat("voices %i/%i  stolen %i  dropped %i", mix.active, config::MAX_VOICES, mix.stolen, mix.dropped),
+		x, y, config::PROFILER_FONT_SIZE, RAYWHITE);
+	y += line * 2;
+	for (auto& total : s.totals) {
+		DrawText(TextFormat("%*s%s %.3f ms", total.depth * 2, "", total.name, total.ms), x, y, config::PROFILER_FONT_SIZE, RAYWHITE);
+		y += line;
+	}
+	/**  allocations in the last frame, by the zone they were made in */
+	auto frame = alloc::get_last_frame();
+	y += line;
+	DrawText(TextFormat("allocs %i  bytes %i  frees %i", static_cast<int>(frame.count), static_cast<int>(frame.bytes),
+		static_cast<int>(frame.frees)), x, y, config::PROFILER_FONT_SIZE, RAYWHITE);
+	y += line;
+	for (std::size_t i = 0; i < alloc::zone_count(); ++i) {
+		auto zone = alloc::get_zone(i);
+		if (zone.count == 0) { continue; }
+		DrawText(TextFormat("  %s %i allocs %i bytes", zone.name, static_cast<int>(zone.count), static_cast<int>(zone.bytes)),
+			x, y, config::PROFILER_FONT_SIZE, ORANGE);
+		y += line;
+	}
+}
+
+/**  complete events, one per zone, in the chrome trace event format */
+bool profiler::export_trace(const char* path){
+	auto& s = state();
+	std::lock_guard lock(s.mutex);
+	auto file = std::ofstream(path);
+	if (not file) {
+		TraceLog(LOG_WARNING, "PROFILER: could not open %s", path);
+		return false;
+	}
+	file << "{\"traceEvents\":[\n";
+	for (std::size_t i = 0; i < s.trace.size(); ++i) {
+		auto& e = s.trace[i];
+		file << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+			<< ",\"ts\":" << e.start << ",\"dur\":" << e.duration << "}" << (i + 1 < s.trace.size() ? ",\n" : "\n");
+	}
+	file << "],\"displayTimeUnit\":\"ms\"}\n";
+	TraceLog(LOG_INFO, "PROFILER: wrote %i zones to %s", static_cast<int>(s.trace.size()), path);
+	return true;
+}
+#endif
@@ -0,0 +1,69 @@
+/*****************************************************************//**
+ * \file   profiler.h
+ * \brief  header file for the frame profiler. Code is instrumented with
+ * scoped zones, each zone records its start and duration. Zones are summed
+ * per frame for the on-screen overlay and kept for export as a chrome trace
+ * (load the file in chrome://tracing or ui.perfetto.dev).
+ *
+ * The profiler is only built when GUNFIGHT_PROFILE is defined (debug builds),
+ * otherwise the macros expand to nothing
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+
+#ifdef GUNFIGHT_PROFILE
+#include <chrono>
+#include <cstddef>
+
+namespace profiler {
+	using clock = std::chrono::steady_clock;
+
+	/**  a completed zone */
+	struct zone_event {
+		const char* name;
+		long long start; // microseconds since the profiler started
+		long long duration;
+		unsigned int thread;
+		int depth; // nesting depth on its thread
+	};
+
+	/**  times the enclosing scope, names must be string literals */
+	class zone {
+	public:
+		explicit zone(const char* name);
+		~zone();
+		zone(const zone&) = delete;
+		zone& operator=(const zone&) = delete;
+	private:
+		const char* name_;
+		clock::time_point start_;
+		int depth_;
+	};
+
+	/**  frames */
+	void begin_frame();
+	void end_frame(std::size_t entity_count);
+
+	/**  the innermost open zone on this thread, or nullptr */
+	const char* current_zone();
+
+	/**  overlay and export */
+	void toggle_overlay();
+	void draw_overlay();
+	bool export_trace(const char* path);
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) profiler::zone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_BEGIN_FRAME() profiler::begin_frame()
+#define PROFILE_END_FRAME(entity_count) profiler::end_frame(entity_count)
+#define PROFILE_DRAW_OVERLAY() profiler::draw_overlay()
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_BEGIN_FRAME()
+#define PROFILE_END_FRAME(entity_count)
+#define PROFILE_DRAW_OVERLAY()
+#endif
@@ -1,4 +1,9 @@
 #include "entities.h"
+#include "profiler.h"
+#include "events.h"
+#include "spatial.h"
+#include "collision.h"
+#include "deferred.h"
 bool entities::projectile::operator==(const entities::entity& other) {
 	if (typeid(*this) != typeid(other)) { return false; }
 	const auto projectile_ptr = dynamic_cast<const entities::projectile*>(&other);
@@ -21,15 +26,25 @@ bool entities::projectile::penetrate(const int& obstacle_penetration) {
 	return penetration_ >= obstacle_penetration;
 }
 
+void entities::projectile::lead(float frames) {
+	position_.x += (speed_direction_.x * speed_direction_.y) * frames;
+}
+
 bool entities::projectile::update(std::vector<std::shared_ptr<entity>>& entities) {
 	// TODO collision both players and entities
-	for (auto& e : entities) {
-		if (CheckCollisionRecs(get_rectangle(), e->get_rectangle()) and this != e.get()) {
-			if (not collide(*e)) {
-				remove_ = true;
-				return false;
-			}
+	PROFILE_ZONE("collisions");
+	/**  everything the bullet reaches this frame is hit, whatever order the list is in. Only
+	 * opaque pixels touching count, a bullet passes through the empty corners of a sprite */
+	auto stopped = false;
+	collision::for_each_hit(entities, *this, [this, &stopped](entities::entity& e) {
+		if (this != &e and not collide(e)) {
+			stopped = true;
 		}
+		return true;
+	});
+	if (stopped) {
+		remove_ = true;
+		return false;
 	}
 	// then check the gunmen
 	position_.x += (speed_direction_.x * speed_direction_.y);
@@ -43,23 +58,23 @@ bool entities::projectile::collide(entities::entity& other) {
 	// if gunman
 	auto gunman = dynamic_cast<entities::gunman*>(&other);
 	if (gunman != nullptr and gunman->get_direction() != speed_direction_.y) {
-		gunman->take_damage(damage_);
+		deferred::damage(*gunman, damage_);
+		deferred::publish({ events::kind::HIT, std::uint8_t(gunman->get_direction() == 1 ? 1 : 2), nullptr, get_position() });
 		return false; // cannot move
 	}
 	// if obstacle
 	auto obstacle = dynamic_cast<entities::obstacle*>(&other);
 	if (obstacle != nullptr) {
-		obstacle->take_damage(damage_);
+		deferred::damage(*obstacle, damage_);
+		deferred::publish({ events::kind::HIT, 0, obstacle->get_archetype(), get_position() });
 		// check penetration for tumbleweeds
-		auto tumbleweed = dynamic_cast<entities::tumbleweed*>(&other);
-		if (tumbleweed == nullptr) {
-			Sound s = LoadSound(config::BULLET_HIT_SOUND);
-			PlaySound(s);
-		}
 		return penetrate(obstacle->get_penetration()); // a revolver can penetrate a tumbleweed but not a cactus
 	}
 	return true;
 }
+int entities::projectile::get_layer() const {
+	return render::PROJECTILES;
+}
 // --------- BULLET ----------------
 
 bool entities::bullet::operator==(const entities::entity& other) {
@@ -67,4 +82,94 @@ bool entities::bullet::operator==(const entities::entity& other) {
 	const auto bullet_ptr = dynamic_cast<const entities::bullet*>(&other);
 	if (bullet_ptr == nullptr) { return false; }
 	return entities::projectile::operator==(other);
-}
\ No newline at end of file
+}
+// --------- DYNAMITE STICK ----------------
+
+namespace {
+	/**  reused by every explosion on the thread, so a chain of them allocates nothing */
+	thread_local std::vector<entities::entity*> caught;
+}
+
+void entities::dynamite_stick::detonate() {
+	det_timer_ = 0;
+}
+
+bool entities::dynamite_stick::is_exploding() const {
+	return explosion_timer_ > 0;
+}
+
+/**  fly until the throw is covered or the edge is reached, then burn the fuse. A stick caught
+ * in another explosion goes off wherever it is, even in the air */
+bool entities::dynamite_stick::update(std::vector<std::shared_ptr<entity>>& entities) {
+	if (is_exploding()) {
+		if (++explosion_timer_ > config::EXPLOSION_FRAMES) {
+			remove_ = true;
+			return false;
+		}
+		return true;
+	}
+	if (throw_distance_ > 0.0f) {
+		auto step = std::min(speed_direction_.x, throw_distance_);
+		position_.x += step * speed_direction_.y;
+		throw_distance_ -= step;
+		auto max_x = config::PLAYABLE_WIDTH - animation_.get_frame_width();
+		if (position_.x < config::PLAYABLE_X or position_.x > max_x) {
+			position_.x = std::clamp(position_.x, static_cast<float>(config::PLAYABLE_X), max_x);
+			throw_distance_ = 0.0f;
+		}
+	}
+	else if (det_timer_ > 0) {
+		--det_timer_;
+	}
+	if (det_timer_ <= 0) {
+		deferred::explode(*this, entities);
+	}
+	return true;
+}
+
+/**  everything in the radius is damaged once, found through the spatial grid. Other sticks are
+ * set off rather than damaged, they explode on their own update so a chain costs one query each.
+ * It runs in the merge, on one thread, so it reaches into the others directly */
+void entities::dynamite_stick::explode(std::vector<std::shared_ptr<entity>>& entities) {
+	PROFILE_ZONE("explosion");
+	auto centre = Vector2{ position_.x + animation_.get_frame_width() / 2, position_.y + animation_.get_frame_height() / 2 };
+	explosion_timer_ = 1;
+	events::publish({ events::kind::EXPLOSION, 0, archetype_, centre });
+	caught.clear();
+	spatial::query_radius(entities, centre, det_radius_, caught);
+	for (auto e : caught) {
+		if (e == this) { continue; }
+		/**  the hit is placed at the middle of what was caught */
+		auto r = e->get_rectangle();
+		auto middle = Vector2{ r.x + r.width / 2, r.y + r.height / 2 };
+		if (auto gunman = dynamic_cast<entities::gunman*>(e); gunman != nullptr) {
+			gunman->take_damage(damage_);
+			events::publish({ events::kind::HIT, std::uint8_t(gunman->get_direction() == 1 ? 1 : 2), nullptr, middle });
+		}
+		else if (auto obstacle = dynamic_cast<entities::obstacle*>(e); obstacle != nullptr) {
+			obstacle->take_damage(damage_);
+			events::publish({ events::kind::HIT, 0, obstacle->get_archetype(), middle });
+		}
+		else if (auto stick = dynamic_cast<entities::dynamite_stick*>(e); stick != nullptr and not stick->is_exploding()) {
+			stick->detonate();
+		}
+	}
+	/**  the stick becomes the explosion, centred where it went off. Its frame is the blast's size,
+	 * so it leaves the collision batch and the grid rather than colliding as one */
+	solid_ = false;
+	animation_ = animation(config::EXPLOSION_PATH, det_radius_ * 2, det_radius_ * 2, config::EXPLOSION_ANIMATION_LENGTH, 1, config::EXPLOSION_FRAME_TIME);
+	position_ = Vector2{ centre.x - det_radius_, centre.y - det_radius_ };
+}
+
+/**  nothing stops a thrown stick, it flies over obstacles and gunmen */
+bool entities::dynamite_stick::collide(entities::entity& other) {
+	return true;
+}
+
+/**  a landed stick lies on the ground, drawn under the gunmen */
+int entities::dynamite_stick::get_layer() const {
+	if (throw_distance_ <= 0.0f and not is_exploding()) {
+		return render::GROUND;
+	}
+	return render::PROJECTILES;
+}
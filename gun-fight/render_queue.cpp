@@ -0,0 +1,52 @@
+/*****************************************************************//**
+ * \file   render_queue.cpp
+ * \brief  implementation file for the render queue
+ * 
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "render_queue.h"
+#include <algorithm>
+
+void render::render_queue::submit(int layer, float y, Texture2D texture, Rectangle source, Vector2 position, Color tint){
+	commands_.push_back(sprite_command{ layer, y, texture, source, position, tint });
+}
+
+void render::render_queue::submit(const render_queue& other){
+	commands_.insert(commands_.end(), other.commands_.begin(), other.commands_.end());
+}
+
+void render::render_queue::clear(){
+	commands_.clear();
+}
+
+void render::render_queue::flush(){
+	/**  stable, so sprites with equal keys keep their submission order */
+	std::stable_sort(commands_.begin(), commands_.end(), [](const sprite_command& a, const sprite_command& b) {
+		if (a.layer != b.layer) { return a.layer < b.layer; }
+		if (a.y != b.y) { return a.y < b.y; }
+		return a.texture.id < b.texture.id;
+		});
+
+	stats_ = render_stats{};
+	stats_.commands = static_cast<int>(commands_.size());
+	bound_.clear();
+	auto current = 0u;
+	for (auto& command : commands_) {
+		/**  raylib batches consecutive draws from the same texture into one draw call */
+		if (stats_.batches == 0 or command.texture.id != current) {
+			current = command.texture.id;
+			++stats_.batches;
+			if (std::find(bound_.begin(), bound_.end(), current) == bound_.end()) {
+				bound_.push_back(current);
+			}
+		}
+		DrawTextureRec(command.texture, command.source, command.position, command.tint);
+	}
+	stats_.texture_binds = static_cast<int>(bound_.size());
+	commands_.clear();
+}
+
+render::render_stats render::render_queue::get_stats() const {
+	return stats_;
+}
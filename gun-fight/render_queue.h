@@ -0,0 +1,60 @@
+/*****************************************************************//**
+ * \file   render_queue.h
+ * \brief  header file for the render queue. Sprites are submitted with a layer
+ * and a y-sort key during drawing, then sorted and flushed once per frame so
+ * that sprites sharing a texture are drawn together
+ * 
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include <vector>
+
+namespace render {
+	/**  draw layers, lower layers are drawn first */
+	enum layer : int {
+		BACKGROUND = 0,
+		GROUND = 1, // items lying on the ground
+		ACTORS = 2, // gunmen and obstacles, sorted by their base
+		PROJECTILES = 3,
+		HUD = 4,
+		OVERLAY = 5
+	};
+
+	/**  a single sprite draw */
+	struct sprite_command {
+		int layer;
+		float y; // sort key within the layer
+		Texture2D texture;
+		Rectangle source;
+		Vector2 position;
+		Color tint;
+	};
+
+	/**  counters for the most recent flush */
+	struct render_stats {
+		int commands = 0;
+		int batches = 0; // runs of consecutive sprites sharing a texture, one draw call each
+		int texture_binds = 0; // distinct textures bound during the flush
+	};
+
+	class render_queue {
+	public:
+		~render_queue() = default;
+		render_queue() = default;
+
+		/**  queue a sprite for drawing this frame */
+		void submit(int layer, float y, Texture2D texture, Rectangle source, Vector2 position, Color tint = WHITE);
+		/**  queue every sprite queued in another, which is left as it was */
+		void submit(const render_queue& other);
+		void clear();
+		/**  sort queued sprites by (layer, y, texture) and draw them, the queue is emptied */
+		void flush();
+		render_stats get_stats() const;
+	private:
+		std::vector<sprite_command> commands_;
+		std::vector<unsigned int> bound_; // scratch list of textures bound during a flush
+		render_stats stats_;
+	};
+}
@@ -0,0 +1,94 @@
+/*****************************************************************//**
+ * \file   resources.cpp
+ * \brief  implementation file for the resource cache
+ * 
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "resources.h"
+#include "bitmask.h"
+#include "config.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+	resources::path_map<Texture2D>& texture_cache() {
+		static resources::path_map<Texture2D> cache;
+		return cache;
+	}
+	resources::path_map<std::unique_ptr<collision::bitmask>>& mask_cache() {
+		static resources::path_map<std::unique_ptr<collision::bitmask>> cache;
+		return cache;
+	}
+	/**  the cache is read by the simulation thread while the render thread draws */
+	std::mutex texture_mutex;
+
+	/**  call with the lock held. A sheet that cannot be read is cached as nullptr so it is only tried once */
+	const collision::bitmask* cache_mask(const char* path, Image image) {
+		auto mask = image.data == nullptr ? nullptr
+			: std::make_unique<collision::bitmask>(collision::bitmask::from_alpha(image, config::MASK_ALPHA_THRESHOLD));
+		return mask_cache().emplace(path, std::move(mask)).first->second.get();
+	}
+	bool headless_mode = false;
+}
+
+Texture2D resources::load_texture(const char* path){
+	if (headless_mode) {
+		return Texture2D{};
+	}
+	auto lock = std::lock_guard(texture_mutex);
+	auto& cache = texture_cache();
+	auto it = cache.find(std::string_view(path));
+	if (it != cache.end()) {
+		return it->second;
+	}
+	/**  the image is read once for both the texture and its mask */
+	auto image = LoadImage(path);
+	auto texture = LoadTextureFromImage(image);
+	if (not mask_cache().contains(std::string_view(path))) {
+		cache_mask(path, image);
+	}
+	UnloadImage(image);
+	cache.emplace(path, texture);
+	return texture;
+}
+
+const collision::bitmask* resources::load_mask(const char* path){
+	auto lock = std::lock_guard(texture_mutex);
+	auto it = mask_cache().find(std::string_view(path));
+	if (it != mask_cache().end()) {
+		return it->second.get();
+	}
+	auto image = LoadImage(path);
+	auto mask = cache_mask(path, image);
+	UnloadImage(image);
+	return mask;
+}
+
+void resources::preload_textures(std::span<const char* const> paths){
+	for (auto path : paths) {
+		load_texture(path);
+	}
+}
+
+void resources::unload_textures(){
+	auto lock = std::lock_guard(texture_mutex);
+	for (auto& [path, texture] : texture_cache()) {
+		UnloadTexture(texture);
+	}
+	texture_cache().clear();
+	mask_cache().clear();
+}
+
+
+
+void resources::set_headless(bool headless){
+	headless_mode = headless;
+}
+
+bool resources::is_headless(){
+	return headless_mode;
+}
@@ -0,0 +1,55 @@
+/*****************************************************************//**
+ * \file   resources.h
+ * \brief  header file for the resource cache. Textures are loaded once per
+ * path and shared, so entities of the same type draw from the same texture.
+ * In headless mode nothing is loaded from disk and the mixer plays nothing, so
+ * the simulation can run without a window or audio device.
+ *
+ * Loading a texture needs the window's thread. The simulation thread only
+ * ever finds textures already in the cache, the ones it can need are loaded
+ * before it starts.
+ *
+ * Every sheet also gets a collision mask built from its alpha as it is
+ * loaded. Masks are made from the image, not the texture, so a headless
+ * simulation hits the same pixels as a windowed one
+ * 
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace collision {
+	class bitmask;
+}
+
+namespace resources {
+	/**  lets a cache keyed by path be searched with a path without building a std::string */
+	struct path_hash {
+		using is_transparent = void;
+		std::size_t operator()(std::string_view path) const {
+			return std::hash<std::string_view>{}(path);
+		}
+	};
+	template<typename T>
+	using path_map = std::unordered_map<std::string, T, path_hash, std::equal_to<>>;
+
+	/**  load a texture, or return the cached texture if the path has already been loaded */
+	Texture2D load_texture(const char* path);
+	/**  load every texture in the list that is not already cached, on the window's thread */
+	void preload_textures(std::span<const char* const> paths);
+	/**  unload every cached texture, call before closing the window */
+	void unload_textures();
+	/**  the collision mask of a sheet, built once per path. nullptr if the sheet could not be read,
+	 * collisions with it fall back to its rectangle */
+	const collision::bitmask* load_mask(const char* path);
+
+	/**  headless mode, set before any entities are created */
+	void set_headless(bool headless);
+	bool is_headless();
+}
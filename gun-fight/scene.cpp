@@ -0,0 +1,297 @@
+/*****************************************************************//**
+ * \file   scene.cpp
+ * \brief  implementation file for scenes and the scene manager
+ * 
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "scene.h"
+#include "profiler.h"
+#include "audio.h"
+#include <chrono>
+
+/**  menus */
+void menu_scene::enter(game_manager& manager){
+	/**  EndDrawing waits for input instead of polling */
+	EnableEventWaiting();
+	screen_.invalidate();
+}
+
+void menu_scene::exit(game_manager& manager){
+	DisableEventWaiting();
+	SetTargetFPS(config::TARGET_FPS);
+	throttled_ = false;
+}
+
+scene_id menu_scene::update(game_manager& manager, double elapsed){
+	/**  throttle while in the background, focus changes wake the loop */
+	auto background = IsWindowMinimized() or not IsWindowFocused();
+	if (background != throttled_) {
+		SetTargetFPS(background ? config::IDLE_FPS : config::TARGET_FPS);
+		throttled_ = background;
+	}
+	/** check if a button on the screen is pressed */
+	auto button = screen_.update();
+	auto it = button_scenes_.find(button);
+	if (it != button_scenes_.end()) {
+		return it->second;
+	}
+	return self_;
+}
+
+void menu_scene::draw(game_manager& manager, double elapsed){
+	screen_.draw();
+}
+
+/**  round intro */
+void pre_round_scene::enter(game_manager& manager){
+	manager.build_level();
+}
+
+/**  the round is not played yet, but its tumbleweeds and wagons are not frozen */
+scene_id pre_round_scene::update(game_manager& manager, double elapsed){
+	manager.animate_entities(GetFrameTime());
+	if (elapsed >= config::PRE_ROUND_TIME) {
+		return scene_id::PLAYING;
+	}
+	return scene_id::PRE_ROUND;
+}
+
+void pre_round_scene::draw(game_manager& manager, double elapsed){
+	/** before each round, draw the round intro texture */
+	BeginDrawing();
+	manager.draw_game();
+	manager.draw_round_intro();
+	EndDrawing();
+}
+
+/**  gameplay, frames are paced here rather than in EndDrawing so input can be polled while waiting.
+ * Everything the simulation may load is loaded now, textures can only be loaded on this thread */
+void playing_scene::enter(game_manager& manager){
+	SetTargetFPS(0);
+	resources::preload_textures(archetype::ROUND_SPRITES);
+	auto& input = manager.get_input();
+	input.clear();
+	input.set_concurrent(true);
+	// the level as the round starts, drawn until the first tick is recorded
+	manager.record_frame();
+	frame_end_ = GetTime();
+	finished_ = false;
+	simulation_ = std::jthread([this, &manager, workers = jobs::bound_pool()](std::stop_token stop) {
+		simulate(stop, manager, workers);
+	});
+}
+
+/**  the game is this thread's again once the simulation has stopped */
+void playing_scene::exit(game_manager& manager){
+	simulation_ = std::jthread();
+	SetTargetFPS(config::TARGET_FPS);
+	auto& input = manager.get_input();
+	input.set_concurrent(false);
+	auto& latency = input.get_latency();
+	TraceLog(LOG_INFO, "INPUT: %i presses, input to display latency mean %.2f ms, max %.2f ms",
+		latency.samples, latency.mean() * 1000.0, latency.max * 1000.0);
+}
+
+/**  tick at the target rate until the round is over. A tick that runs long is not caught up on,
+ * the next one starts straight away */
+void playing_scene::simulate(std::stop_token stop, game_manager& manager, jobs::pool* workers){
+	// share the entities' update with the same workers as the window's thread
+	jobs::bind_pool(workers);
+	auto next = GetTime();
+	while (not stop.stop_requested() and tick(manager)) {
+		next += 1.0 / config::TARGET_FPS;
+		auto now = GetTime();
+		if (next > now) {
+			std::this_thread::sleep_for(std::chrono::duration<double>(next - now));
+		}
+		else {
+			next = now;
+		}
+	}
+	finished_ = true;
+}
+
+/**  update the game by one frame, on the simulation thread */
+bool playing_scene::tick(game_manager& manager){
+	PROFILE_ZONE("tick");
+	// take the input sampled since the last tick, as late as possible before simulating
+	auto& input = manager.get_input();
+	input.begin_frame();
+	// temp for quickly cycling through rounds to test environment generation
+	if (input.pressed(KEY_X)) {
+		manager.end_round();
+	}
+	// update players, check they are alive, increase scores, end the round
+	manager.update_players();
+	// check and spawn items if enough time has elapsed
+	manager.spawn_items();
+	// then update entnties
+	manager.update_entities();
+	// and remove them 
+	manager.remove_entities();
+	// advance animations by one tick
+	manager.animate_entities(1.0f / config::TARGET_FPS);
+	// then increase frame_count 
+	manager.increment_frame_count();
+	// show the deaths, then hand the frame to the renderer and the spectators
+	manager.present_events();
+	manager.record_frame();
+	input.end_frame();
+	manager.record_killcam();
+	manager.broadcast_state();
+	return not manager.game_over() and not manager.is_round_over();
+}
+
+/**  the simulation runs by itself, the scene changes once it has stopped */
+scene_id playing_scene::update(game_manager& manager, double elapsed){
+	PROFILE_BEGIN_FRAME();
+#ifdef GUNFIGHT_PROFILE
+	if (IsKeyPressed(config::PROFILER_OVERLAY_KEY)) {
+		profiler::toggle_overlay();
+	}
+	if (IsKeyPressed(config::PROFILER_TRACE_KEY)) {
+		profiler::export_trace(config::TRACE_PATH);
+	}
+#endif
+	if (not finished_) {
+		return scene_id::PLAYING;
+	}
+	if (manager.game_over()) {
+		return scene_id::GAME_OVER;
+	}
+	return scene_id::POST_ROUND;
+}
+
+void playing_scene::draw(game_manager& manager, double elapsed){
+	BeginDrawing();
+	manager.draw_frame();
+	PROFILE_DRAW_OVERLAY();
+	EndDrawing();
+	PROFILE_END_FRAME(manager.get_drawn_entity_count());
+	auto& input = manager.get_input();
+	input.presented();
+	// wait out the rest of the frame polling input, fall back to now if a frame ran long
+	frame_end_ = std::max(frame_end_ + 1.0 / config::TARGET_FPS, GetTime());
+	input.pace(frame_end_);
+}
+
+/**  after a kill, replays it then makes time for the death animation */
+void post_round_scene::enter(game_manager& manager){
+	manager.pregenerate_level();
+}
+
+scene_id post_round_scene::update(game_manager& manager, double elapsed){
+	manager.animate_entities(GetFrameTime());
+	if (elapsed >= manager.get_killcam_length() + config::POST_ROUND_TIME) {
+		return scene_id::PRE_ROUND;
+	}
+	return scene_id::POST_ROUND;
+}
+
+void post_round_scene::draw(game_manager& manager, double elapsed){
+	BeginDrawing();
+	if (elapsed < manager.get_killcam_length()) {
+		manager.draw_killcam(elapsed);
+	}
+	else {
+		manager.draw_game();
+	}
+	EndDrawing();
+}
+
+/**  game over, hold the final frame then show the winner */
+void game_over_scene::enter(game_manager& manager){
+	voiceline_played_ = false;
+}
+
+/**  the winning kill is replayed first */
+scene_id game_over_scene::update(game_manager& manager, double elapsed){
+	manager.animate_entities(GetFrameTime());
+	elapsed -= manager.get_killcam_length();
+	if (elapsed >= config::GAME_OVER_DELAY and not voiceline_played_) {
+		manager.play_voiceline();
+		voiceline_played_ = true;
+	}
+	/**  go back to the main menu */
+	if (elapsed >= config::GAME_OVER_TIME) {
+		manager.reset_scores();
+		return scene_id::MAIN_MENU;
+	}
+	return scene_id::GAME_OVER;
+}
+
+void game_over_scene::draw(game_manager& manager, double elapsed){
+	BeginDrawing();
+	auto replay = manager.get_killcam_length();
+	if (elapsed < replay) {
+		manager.draw_killcam(elapsed);
+	}
+	else if (elapsed - replay < config::GAME_OVER_DELAY) {
+		manager.draw_game();
+	}
+	else {
+		manager.draw_game_over();
+	}
+	EndDrawing();
+}
+
+/**  scene manager */
+scene_manager::scene_manager(game_manager& manager, screen& main_menu, screen& control_screen)
+	: manager_(manager) {
+	scenes_[scene_id::MAIN_MENU] = std::make_unique<menu_scene>(main_menu,
+		std::map<int, scene_id>{ {0, scene_id::PRE_ROUND}, { 1, scene_id::CONTROLS }, { 2, scene_id::QUIT } }, scene_id::MAIN_MENU);
+	scenes_[scene_id::CONTROLS] = std::make_unique<menu_scene>(control_screen,
+		std::map<int, scene_id>{ {0, scene_id::MAIN_MENU} }, scene_id::CONTROLS);
+	scenes_[scene_id::PRE_ROUND] = std::make_unique<pre_round_scene>();
+	scenes_[scene_id::PLAYING] = std::make_unique<playing_scene>();
+	scenes_[scene_id::POST_ROUND] = std::make_unique<post_round_scene>();
+	scenes_[scene_id::GAME_OVER] = std::make_unique<game_over_scene>();
+	scene_start_ = GetTime();
+	scenes_.at(current_)->enter(manager_);
+}
+
+scene_manager::~scene_manager(){
+	shutdown();
+}
+
+void scene_manager::update(){
+	if (should_quit()) { return; }
+	audio::update();
+	auto next = scenes_.at(current_)->update(manager_, GetTime() - scene_start_);
+	audio::consume(manager_.get_audio_events());
+	if (current_ != scene_id::PLAYING) {
+		manager_.broadcast_state();
+	}
+	if (next != current_) {
+		change_scene(next);
+	}
+}
+
+void scene_manager::draw(){
+	if (should_quit()) { return; }
+	scenes_.at(current_)->draw(manager_, GetTime() - scene_start_);
+}
+
+bool scene_manager::should_quit(){
+	return current_ == scene_id::QUIT;
+}
+
+scene_id scene_manager::get_scene(){
+	return current_;
+}
+
+void scene_manager::shutdown(){
+	if (not should_quit()) {
+		change_scene(scene_id::QUIT);
+	}
+}
+
+void scene_manager::change_scene(scene_id next){
+	scenes_.at(current_)->exit(manager_);
+	current_ = next;
+	scene_start_ = GetTime();
+	if (not should_quit()) {
+		scenes_.at(current_)->enter(manager_);
+	}
+}
@@ -0,0 +1,130 @@
+/*****************************************************************//**
+ * \file   scene.h
+ * \brief  header file for scenes - the menus, round transitions and gameplay.
+ * The scene manager is ticked once per frame by the main loop, scenes never 
+ * block, timed transitions are measured from when the scene was entered
+ * 
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "game_manager.h"
+#include "screen.h"
+#include "jobs.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <stop_token>
+#include <thread>
+
+enum class scene_id : int {
+	MAIN_MENU = 0,
+	CONTROLS = 1,
+	PRE_ROUND = 2,
+	PLAYING = 3,
+	POST_ROUND = 4,
+	GAME_OVER = 5,
+	QUIT = 6
+};
+
+/**  superclass for scenes, update returns the scene to run next */
+class scene {
+public:
+	virtual ~scene() = default;
+	scene() = default;
+	virtual void enter(game_manager& manager) {};
+	virtual void exit(game_manager& manager) {};
+	virtual scene_id update(game_manager& manager, double elapsed) = 0; // elapsed is the time since the scene was entered
+	virtual void draw(game_manager& manager, double elapsed) = 0;
+};
+
+/**
+ * a menu screen, buttons map to the scene that they open. Menus are idle most of the time,
+ * the loop sleeps until input arrives and is throttled while the window is in the background
+ */
+class menu_scene : public scene {
+public:
+	menu_scene(screen& menu_screen, std::map<int, scene_id> button_scenes, scene_id self)
+		: screen_(menu_screen), button_scenes_(button_scenes), self_(self) {
+	};
+	void enter(game_manager& manager) override;
+	void exit(game_manager& manager) override;
+	scene_id update(game_manager& manager, double elapsed) override;
+	void draw(game_manager& manager, double elapsed) override;
+private:
+	screen& screen_;
+	std::map<int, scene_id> button_scenes_;
+	scene_id self_;
+	bool throttled_ = false;
+};
+
+/**  builds the level and shows the round intro */
+class pre_round_scene : public scene {
+public:
+	void enter(game_manager& manager) override;
+	scene_id update(game_manager& manager, double elapsed) override;
+	void draw(game_manager& manager, double elapsed) override;
+};
+
+/**
+ * the round being played. The simulation ticks on its own thread at a fixed rate and records
+ * a frame after each tick, the window's thread draws the latest frame and samples the input.
+ * Neither waits for the other, a slow buffer swap never holds up the simulation
+ */
+class playing_scene : public scene {
+public:
+	void enter(game_manager& manager) override;
+	void exit(game_manager& manager) override;
+	scene_id update(game_manager& manager, double elapsed) override;
+	void draw(game_manager& manager, double elapsed) override;
+private:
+	void simulate(std::stop_token stop, game_manager& manager, jobs::pool* workers);
+	bool tick(game_manager& manager); // false once the round is over
+
+	double frame_end_ = 0.0; // when the next frame is due, input is polled until then
+	std::atomic<bool> finished_ = false; // the simulation has stopped at the end of the round
+	std::jthread simulation_; // last, so it is stopped before anything it uses goes
+};
+
+/**  replays the kill, then holds the final scene of the round. The next level is generated meanwhile */
+class post_round_scene : public scene {
+public:
+	void enter(game_manager& manager) override;
+	scene_id update(game_manager& manager, double elapsed) override;
+	void draw(game_manager& manager, double elapsed) override;
+};
+
+/**  replays the winning kill and holds the final frame, then shows the winner with a voiceline */
+class game_over_scene : public scene {
+public:
+	void enter(game_manager& manager) override;
+	scene_id update(game_manager& manager, double elapsed) override;
+	void draw(game_manager& manager, double elapsed) override;
+private:
+	bool voiceline_played_ = false;
+};
+
+/**  owns the scenes and runs the current one */
+class scene_manager {
+public:
+	~scene_manager();
+	scene_manager(game_manager& manager, screen& main_menu, screen& control_screen);
+
+	/**  tick and draw the current scene, called once per frame. The round being played is
+	 * ticked on its own thread, which also broadcasts it */
+	void update();
+	void draw();
+	bool should_quit();
+	scene_id get_scene();
+	/**  exit the current scene, joining a round's simulation thread. Call before the audio device
+	 * and window are closed */
+	void shutdown();
+private:
+	void change_scene(scene_id next);
+
+	game_manager& manager_;
+	std::map<scene_id, std::unique_ptr<scene>> scenes_;
+	scene_id current_ = scene_id::MAIN_MENU;
+	double scene_start_ = 0.0;
+};
@@ -1,8 +1,15 @@
 #include "screen.h"
 
 int screen::update(){
+	if (IsWindowResized()) {
+		dirty_ = true;
+	}
 	for (auto i = 0; i < buttons_.size(); ++i) {
-		if (buttons_.at(i).update()) {
+		auto pressed = buttons_.at(i).update();
+		if (buttons_.at(i).has_changed()) {
+			dirty_ = true;
+		}
+		if (pressed) {
 			PlaySound(button_sound_);
 			return i;
 		}
@@ -11,13 +18,25 @@ int screen::update(){
 
 }
 void screen::draw(){
+	/**  menus are static until a button changes, so reuse the last composed frame */
+	if (dirty_ or not cache_.is_rendered()) {
+		cache_.begin_render();
+		auto background_pos = Vector2{ 0,0 };
+		background_.draw_frame(background_pos);
+		draw_strategy_->draw(background_, buttons_);
+		cache_.end_render();
+		dirty_ = false;
+	}
 	BeginDrawing();
-	auto background_pos = Vector2{ 0,0 };
-	background_.draw_frame(background_pos);
-	draw_strategy_->draw(background_, buttons_);
+	cache_.draw(queue_);
+	queue_.flush();
 	EndDrawing();
 }
 
+void screen::invalidate(){
+	dirty_ = true;
+}
+
 void main_menu_strategy::draw(animation& background, std::vector<button>& buttons){
 	//draw play, the x is the centre of the screen - half button width
 	auto button_pos = Vector2{ config::SCREEN_WIDTH_HALF - (config::BUTTON_WIDTH / 2), config::BUTTONS_START_Y };
@@ -10,6 +10,8 @@
 #include "animation.h"
 #include "config.h"
 #include "button.h"
+#include "hud.h"
+#include "render_queue.h"
 #include <vector>
 #include <utility>
 #include <memory>
@@ -67,19 +69,27 @@ public:
     ~screen() = default;
     template <typename InputIt>
     screen(const char* path, float width, float height, int anim_length, int anims, int button_offset, InputIt first, InputIt last, std::unique_ptr<draw_strategy> draw_strat)
-        : background_(animation(path, width, height, anim_length, anims)), buttons_(first, last), button_offset_(button_offset), draw_strategy_(std::move(draw_strat)) {
+        : background_(animation(path, width, height, anim_length, anims)), buttons_(first, last), button_offset_(button_offset), draw_strategy_(std::move(draw_strat)),
+        cache_(hud_panel(0.0, 0.0, static_cast<int>(width), static_cast<int>(height))) {
         button_sound_ = LoadSound(config::BUTTON_SOUND_PATH);
     }
     screen(const screen& other)
-        : background_(other.background_), buttons_(other.buttons_), button_offset_(other.button_offset_), button_sound_(other.button_sound_) {
+        : background_(other.background_), buttons_(other.buttons_), button_offset_(other.button_offset_), button_sound_(other.button_sound_),
+        cache_(other.cache_), dirty_(other.dirty_) {
 		draw_strategy_ = other.draw_strategy_->clone();
     }
     int update();
     void draw();
+    void invalidate(); // recompose the screen on the next draw
 private:
     animation background_;
     std::vector<button> buttons_;
     int button_offset_;
     std::unique_ptr<draw_strategy> draw_strategy_;
     Sound button_sound_;
+
+    /**  the composed screen, only recomposed when a button changes */
+    hud_panel cache_;
+    render::render_queue queue_;
+    bool dirty_ = true;
 };
\ No newline at end of file
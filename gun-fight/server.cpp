@@ -0,0 +1,314 @@
+/*****************************************************************//**
+ * \file   server.cpp
+ * \brief  implementation file for the dedicated server
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "server.h"
+#include "resources.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+	constexpr std::uint16_t MAGIC = 0x4347; // "GC"
+	constexpr std::size_t MESSAGE_SIZE = 4;
+	const int PRE_ROUND_TICKS = static_cast<int>(config::PRE_ROUND_TIME * config::TARGET_FPS);
+	const int POST_ROUND_TICKS = static_cast<int>(config::POST_ROUND_TIME * config::TARGET_FPS);
+
+	using clock = std::chrono::steady_clock;
+
+	double seconds_since(clock::time_point start) {
+		return std::chrono::duration<double>(clock::now() - start).count();
+	}
+
+	/**  the held bit for a movement direction */
+	std::uint8_t direction_bit(const Vector2& direction) {
+		if (direction.y < 0) { return server::UP; }
+		if (direction.x < 0) { return server::LEFT; }
+		if (direction.y > 0) { return server::DOWN; }
+		return server::RIGHT;
+	}
+
+	std::uint64_t route_key(const net::endpoint& e) {
+		return (std::uint64_t(e.address) << 16) | e.port;
+	}
+
+	/**  tick time of one worker, swapped out by the reports */
+	struct worker_stats {
+		std::atomic<long long> busy_ns = 0;
+		std::atomic<long long> ticks = 0;
+		std::atomic<long long> overruns = 0; // ticks that started late because the last one ran long
+		int matches = 0;
+	};
+
+	void report(std::vector<worker_stats>& workers, int clients) {
+		auto frame_ms = 1000.0 / config::TARGET_FPS;
+		for (std::size_t i = 0; i < workers.size(); ++i) {
+			auto& w = workers[i];
+			auto busy = w.busy_ns.exchange(0);
+			auto ticks = w.ticks.exchange(0);
+			auto overruns = w.overruns.exchange(0);
+			if (ticks == 0 or w.matches == 0) { continue; }
+			auto match_ms = busy / 1e6 / ticks / w.matches;
+			TraceLog(LOG_INFO, "SERVER: worker %i, %i matches, %.3f ms per match tick, %lld late ticks, one core sustains %i matches at %i Hz",
+				static_cast<int>(i), w.matches, match_ms, overruns, static_cast<int>(frame_ms / match_ms), config::TARGET_FPS);
+		}
+		TraceLog(LOG_INFO, "SERVER: %i clients connected", clients);
+	}
+}
+
+void server::apply_input(input::input_queue& input, int slot, const input_message& message){
+	auto& movement = slot == 0 ? config::GUNMAN1_MOVEMENT : config::GUNMAN2_MOVEMENT;
+	auto& firing = slot == 0 ? config::GUNMAN1_FIRING : config::GUNMAN2_FIRING;
+	for (auto& [key, direction] : movement) {
+		input.hold(key, (message.held & direction_bit(direction)) != 0);
+	}
+	if (message.pressed & FIRE) { input.push(firing.first); }
+	if (message.pressed & RELOAD) { input.push(firing.second); }
+	if (message.pressed & ITEM) { input.push(slot == 0 ? config::P1_ITEM_KEY : config::P2_ITEM_KEY); }
+}
+
+/**  match */
+server::match::match(unsigned int seed)
+	: manager_(player::create(1), player::create(2)) {
+	manager_.seed(seed);
+	manager_.get_input().set_keyboard(false);
+	manager_.build_level();
+}
+
+int server::match::join(const net::endpoint& address, double now){
+	auto lock = std::lock_guard(mutex_);
+	for (auto slot = 0; slot < static_cast<int>(clients_.size()); ++slot) {
+		if (not clients_[slot].connected) {
+			clients_[slot] = client{ true, address, now };
+			keyframe_requested_ = true;
+			return slot;
+		}
+	}
+	return -1;
+}
+
+void server::match::deliver(int slot, const input_message& input, double now){
+	auto lock = std::lock_guard(mutex_);
+	clients_[slot].last_seen = now;
+	inbox_.emplace_back(slot, input);
+}
+
+void server::match::expire(double now, std::vector<net::endpoint>& expired){
+	auto lock = std::lock_guard(mutex_);
+	for (auto& c : clients_) {
+		if (c.connected and now - c.last_seen > config::SPECTATOR_TIMEOUT) {
+			expired.push_back(c.address);
+			c.connected = false;
+		}
+	}
+}
+
+/**  the clients' inputs in the order they arrived */
+void server::match::apply_inputs(){
+	{
+		auto lock = std::lock_guard(mutex_);
+		inputs_.swap(inbox_);
+	}
+	for (auto& [slot, message] : inputs_) {
+		apply_input(manager_.get_input(), slot, message);
+	}
+	inputs_.clear();
+}
+
+/**  the playing, post round and pre round scenes, counted in ticks instead of seconds */
+void server::match::tick(){
+	apply_inputs();
+	auto& input = manager_.get_input();
+	switch (phase_) {
+		case phase::PRE_ROUND:
+			if (++phase_ticks_ >= PRE_ROUND_TICKS) {
+				input.clear();
+				phase_ = phase::PLAYING;
+			}
+			break;
+		case phase::PLAYING:
+			input.begin_frame();
+			manager_.update_players();
+			manager_.spawn_items();
+			manager_.update_entities();
+			manager_.remove_entities();
+			manager_.animate_entities(1.0f / config::TARGET_FPS);
+			manager_.increment_frame_count();
+			if (manager_.is_round_over()) {
+				/**  a finished game goes straight on to the next one */
+				if (manager_.game_over()) {
+					manager_.reset_scores();
+				}
+				manager_.pregenerate_level();
+				phase_ = phase::POST_ROUND;
+				phase_ticks_ = 0;
+			}
+			break;
+		case phase::POST_ROUND:
+			if (++phase_ticks_ >= POST_ROUND_TICKS) {
+				manager_.build_level();
+				phase_ = phase::PRE_ROUND;
+				phase_ticks_ = 0;
+			}
+			break;
+	}
+	/**  nobody hears the sounds, the dead pose is still shown to the clients */
+	manager_.get_audio_events().drain([](auto&) {});
+	manager_.present_events();
+}
+
+/**  encode once and send to both players */
+void server::match::send_state(net::udp_socket& socket){
+	auto to = std::array<net::endpoint, 2>{};
+	auto count = 0;
+	{
+		auto lock = std::lock_guard(mutex_);
+		for (auto& c : clients_) {
+			if (c.connected) { to[count++] = c.address; }
+		}
+		if (keyframe_requested_) {
+			encoder_.request_keyframe();
+			keyframe_requested_ = false;
+		}
+	}
+	if (count == 0) {
+		encoder_.reset();
+		return;
+	}
+	if (not encoder_.encode(manager_.get_entities(), manager_.get_match_state())) { return; }
+	auto& packet = encoder_.get_packet();
+	for (auto i = 0; i < count; ++i) {
+		socket.send(to[i], packet.data(), packet.size());
+	}
+}
+
+/**  server */
+int server::run(const options& o){
+	resources::set_headless(true);
+	auto socket = net::udp_socket();
+	if (not socket.open(o.port)) {
+		std::cout << "could not open port " << o.port << std::endl;
+		return 1;
+	}
+	auto seed = std::random_device{}();
+	auto matches = std::vector<std::unique_ptr<match>>{};
+	for (auto i = 0; i < o.matches; ++i) {
+		matches.push_back(std::make_unique<match>(seed + i));
+	}
+
+	/**  one worker per core, match i is ticked by worker i % workers */
+	auto worker_count = std::max(1, std::min(o.matches, static_cast<int>(std::thread::hardware_concurrency())));
+	auto stats = std::vector<worker_stats>(worker_count);
+	auto workers = std::vector<std::jthread>{};
+	for (auto w = 0; w < worker_count; ++w) {
+		auto shard = std::vector<match*>{};
+		for (auto i = w; i < o.matches; i += worker_count) {
+			shard.push_back(matches[i].get());
+		}
+		stats[w].matches = static_cast<int>(shard.size());
+		workers.emplace_back([shard, &socket, &s = stats[w]](std::stop_token stop) {
+			auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / config::TARGET_FPS));
+			auto next = clock::now();
+			while (not stop.stop_requested()) {
+				auto start = clock::now();
+				for (auto m : shard) {
+					m->tick();
+					m->send_state(socket);
+				}
+				auto end = clock::now();
+				s.busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+				++s.ticks;
+				next += period;
+				if (end > next) {
+					++s.overruns;
+					next = end;
+				}
+				std::this_thread::sleep_until(next);
+			}
+		});
+	}
+	TraceLog(LOG_INFO, "SERVER: %i matches on %i workers, port %i", o.matches, worker_count, o.port);
+
+	/**  route input to matches until the time is up */
+	auto start = clock::now();
+	auto routes = std::unordered_map<std::uint64_t, std::pair<match*, int>>{};
+	auto expired = std::vector<net::endpoint>{};
+	auto buffer = std::array<std::uint8_t, 64>{};
+	auto from = net::endpoint{};
+	auto last_expiry = 0.0;
+	auto last_report = 0.0;
+	while (o.seconds <= 0.0 or seconds_since(start) < o.seconds) {
+		auto now = seconds_since(start);
+		auto received = false;
+		while (auto size = socket.receive(buffer.data(), buffer.size(), from)) {
+			received = true;
+			if (size != MESSAGE_SIZE or (buffer[0] | (buffer[1] << 8)) != MAGIC) { continue; }
+			auto route = routes.find(route_key(from));
+			if (route == routes.end()) {
+				for (auto& m : matches) {
+					if (auto slot = m->join(from, now); slot >= 0) {
+						route = routes.emplace(route_key(from), std::pair{ m.get(), slot }).first;
+						break;
+					}
+				}
+				if (route == routes.end()) { continue; } // every match is full
+			}
+			route->second.first->deliver(route->second.second, input_message{ buffer[2], buffer[3] }, now);
+		}
+		if (now - last_expiry >= 1.0) {
+			for (auto& m : matches) {
+				m->expire(now, expired);
+			}
+			for (auto& e : expired) {
+				routes.erase(route_key(e));
+			}
+			expired.clear();
+			last_expiry = now;
+		}
+		if (now - last_report >= config::SERVER_REPORT_INTERVAL) {
+			report(stats, static_cast<int>(routes.size()));
+			last_report = now;
+		}
+		if (not received) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+	for (auto& w : workers) {
+		w.request_stop();
+	}
+	workers.clear();
+	report(stats, static_cast<int>(routes.size()));
+	return 0;
+}
+
+/**  client */
+void server::run_client(net::endpoint server){
+	auto view = spectator::viewer(server);
+	auto queue = render::render_queue();
+	while (not WindowShouldClose() and view.is_open()) {
+		auto held = std::uint8_t{ 0 };
+		for (auto& [key, direction] : config::GUNMAN1_MOVEMENT) {
+			if (IsKeyDown(key)) { held |= direction_bit(direction); }
+		}
+		auto pressed = std::uint8_t{ 0 };
+		if (IsKeyPressed(config::GUNMAN1_FIRING.first)) { pressed |= FIRE; }
+		if (IsKeyPressed(config::GUNMAN1_FIRING.second)) { pressed |= RELOAD; }
+		if (IsKeyPressed(config::P1_ITEM_KEY)) { pressed |= ITEM; }
+		auto message = std::array<std::uint8_t, MESSAGE_SIZE>{ std::uint8_t(MAGIC), std::uint8_t(MAGIC >> 8), held, pressed };
+		view.send(message.data(), message.size());
+
+		view.poll();
+		BeginDrawing();
+		ClearBackground(BLACK);
+		view.draw(queue);
+		EndDrawing();
+	}
+}
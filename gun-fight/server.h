@@ -0,0 +1,110 @@
+/*****************************************************************//**
+ * \file   server.h
+ * \brief  header file for the dedicated server. One headless process hosts
+ * many matches, each its own game_manager with its own random numbers,
+ * arenas and event bus, so matches share no mutable state. The matches are
+ * split across one worker thread per core, and each worker ticks its share
+ * at 60 Hz. The main thread owns the UDP socket: it routes each client's
+ * input to its match, and the workers send the matches' state straight back.
+ *
+ * A client joins by sending its input, it takes the first free slot, so the
+ * first two clients play each other. Clients are sent the match in the
+ * spectator stream format, see spectator.h.
+ *
+ * client to server, every frame:
+ *   u16 magic, u8 held (1 up, 2 left, 4 down, 8 right), u8 pressed (1 fire, 2 reload, 4 item)
+ *
+ * Each worker reports how long a match tick takes on its core and so how
+ * many matches one core sustains at the target frame rate
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "game_manager.h"
+#include "spectator.h"
+#include "net.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace server {
+	enum held_bits : std::uint8_t {
+		UP = 1,
+		LEFT = 2,
+		DOWN = 4,
+		RIGHT = 8
+	};
+	enum pressed_bits : std::uint8_t {
+		FIRE = 1,
+		RELOAD = 2,
+		ITEM = 4
+	};
+
+	/**  one client's controls, as sent each frame */
+	struct input_message {
+		std::uint8_t held = 0;
+		std::uint8_t pressed = 0;
+	};
+
+	/**  hold the movement keys of the slot's player and queue its presses, slot 0 is player 1 */
+	void apply_input(input::input_queue& input, int slot, const input_message& message);
+
+	/**  one hosted game. Joining and delivering input happen on the network
+	 * thread, ticking and sending on the match's worker */
+	class match {
+	public:
+		/**  constructors and destructors */
+		~match() = default;
+		explicit match(unsigned int seed);
+		match(const match&) = delete;
+		match& operator=(const match&) = delete;
+
+		/**  network thread */
+		int join(const net::endpoint& address, double now); // the slot taken, -1 if the match is full
+		void deliver(int slot, const input_message& input, double now);
+		void expire(double now, std::vector<net::endpoint>& expired); // clients that stopped sending
+
+		/**  worker thread */
+		void tick();
+		void send_state(net::udp_socket& socket);
+	private:
+		enum class phase {
+			PRE_ROUND,
+			PLAYING,
+			POST_ROUND
+		};
+		struct client {
+			bool connected = false;
+			net::endpoint address;
+			double last_seen = 0.0;
+		};
+
+		void apply_inputs();
+
+		game_manager manager_;
+		spectator::encoder encoder_;
+		phase phase_ = phase::PRE_ROUND;
+		int phase_ticks_ = 0;
+
+		/**  shared with the network thread */
+		std::mutex mutex_;
+		std::array<client, 2> clients_;
+		std::vector<std::pair<int, input_message>> inbox_;
+		bool keyframe_requested_ = false;
+		std::vector<std::pair<int, input_message>> inputs_; // the inbox taken by the worker
+	};
+
+	struct options {
+		int matches = config::SERVER_MATCHES;
+		std::uint16_t port = config::SERVER_PORT;
+		double seconds = 0.0; // 0 runs until the process is stopped
+	};
+
+	/**  host the matches, returns the exit code */
+	int run(const options& o);
+
+	/**  play on a server with player 1's keys until the window is closed, the window must be open */
+	void run_client(net::endpoint server);
+}
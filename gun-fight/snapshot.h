@@ -0,0 +1,38 @@
+/*****************************************************************//**
+ * \file   snapshot.h
+ * \brief  header file for render snapshots, everything needed to draw one
+ * frame of a round. The simulation records a snapshot at the end of each
+ * tick and hands it to the render thread through a triple buffer, so the
+ * renderer never reads an entity the simulation may be moving. Sprites are
+ * recorded as queued draw commands, textures are only ever loaded, bound and
+ * rendered into on the render thread
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "animation.h"
+#include "hud.h"
+#include "render_queue.h"
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace render {
+	/**  what a player's hud panel shows, the weapon and item sprites are copied at their current frame */
+	struct player_view {
+		hud_state hud;
+		animation weapon;
+		animation item;
+	};
+
+	struct snapshot {
+		render_queue sprites; // the entities, gunmen and dynamite markers
+		std::array<player_view, 2> players;
+		std::pair<int, int> scores = { 0, 0 };
+		std::vector<Vector2> dust; // the base of each tumbleweed, where it kicks up dust
+		std::size_t entity_count = 0;
+	};
+}
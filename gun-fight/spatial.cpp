@@ -0,0 +1,145 @@
+/*****************************************************************//**
+ * \file   spatial.cpp
+ * \brief  implementation file for the spatial grid
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "spatial.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	thread_local spatial::grid* bound = nullptr;
+}
+
+bool spatial::circle_overlaps(Vector2 centre, float radius, const Rectangle& rectangle){
+	auto x = std::clamp(centre.x, rectangle.x, rectangle.x + rectangle.width);
+	auto y = std::clamp(centre.y, rectangle.y, rectangle.y + rectangle.height);
+	auto dx = centre.x - x;
+	auto dy = centre.y - y;
+	return dx * dx + dy * dy <= radius * radius;
+}
+
+spatial::grid::grid()
+	: columns_(static_cast<int>(std::ceil(config::SCREEN_WIDTH / config::SPATIAL_CELL_SIZE))),
+	rows_(static_cast<int>(std::ceil(config::SCREEN_HEIGHT / config::SPATIAL_CELL_SIZE))) {
+	cell_start_.resize(static_cast<std::size_t>(columns_) * rows_ + 1);
+}
+
+int spatial::grid::column(float x) const {
+	return std::clamp(static_cast<int>(std::floor(x / config::SPATIAL_CELL_SIZE)), 0, columns_ - 1);
+}
+
+int spatial::grid::row(float y) const {
+	return std::clamp(static_cast<int>(std::floor(y / config::SPATIAL_CELL_SIZE)), 0, rows_ - 1);
+}
+
+/**  counted then filled, so every cell's entries sit together in one array and nothing is allocated once warm */
+void spatial::grid::build(const std::vector<std::shared_ptr<entities::entity>>& entities){
+	PROFILE_ZONE("spatial_build");
+	entities_.clear();
+	rectangles_.clear();
+	for (auto& e : entities) {
+		entities_.push_back(e.get());
+		rectangles_.push_back(e->get_rectangle());
+	}
+	stamps_.assign(entities_.size(), stamp_);
+
+	/**  count the entries of each cell */
+	std::fill(cell_start_.begin(), cell_start_.end(), 0);
+	for (std::uint32_t i = 0; i < rectangles_.size(); ++i) {
+		/**  entities that are not solid keep their index but are in no cell */
+		if (not entities_[i]->is_solid()) { continue; }
+		auto& r = rectangles_[i];
+		for (auto y = row(r.y); y <= row(r.y + r.height); ++y) {
+			for (auto x = column(r.x); x <= column(r.x + r.width); ++x) {
+				++cell_start_[y * columns_ + x + 1];
+			}
+		}
+	}
+	for (std::size_t c = 1; c < cell_start_.size(); ++c) {
+		cell_start_[c] += cell_start_[c - 1];
+	}
+
+	/**  fill each cell from its start, the start is restored by the fill */
+	cells_.resize(cell_start_.back());
+	for (std::uint32_t i = 0; i < rectangles_.size(); ++i) {
+		if (not entities_[i]->is_solid()) { continue; }
+		auto& r = rectangles_[i];
+		for (auto y = row(r.y); y <= row(r.y + r.height); ++y) {
+			for (auto x = column(r.x); x <= column(r.x + r.width); ++x) {
+				cells_[cell_start_[y * columns_ + x]++] = i;
+			}
+		}
+	}
+	for (auto c = cell_start_.size() - 1; c > 0; --c) {
+		cell_start_[c] = cell_start_[c - 1];
+	}
+	cell_start_[0] = 0;
+
+	source_ = &entities;
+	source_size_ = entities.size();
+	valid_ = true;
+	++stats_.builds;
+}
+
+void spatial::grid::invalidate(){
+	valid_ = false;
+	stats_ = grid_stats{};
+}
+
+/**  entities added since the build would be missed, so a grown list is rebuilt */
+bool spatial::grid::is_built_for(const std::vector<std::shared_ptr<entities::entity>>& entities) const {
+	return valid_ and source_ == &entities and source_size_ == entities.size();
+}
+
+void spatial::grid::query(Vector2 centre, float radius, std::vector<entities::entity*>& found){
+	++stats_.queries;
+	++stamp_;
+	for (auto y = row(centre.y - radius); y <= row(centre.y + radius); ++y) {
+		for (auto x = column(centre.x - radius); x <= column(centre.x + radius); ++x) {
+			auto cell = y * columns_ + x;
+			for (auto i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+				auto index = cells_[i];
+				if (stamps_[index] == stamp_) { continue; }
+				stamps_[index] = stamp_;
+				++stats_.tested;
+				if (circle_overlaps(centre, radius, rectangles_[index])) {
+					found.push_back(entities_[index]);
+					++stats_.found;
+				}
+			}
+		}
+	}
+}
+
+spatial::grid_stats spatial::grid::get_stats() const {
+	return stats_;
+}
+
+spatial::grid* spatial::bound_grid(){
+	return bound;
+}
+
+void spatial::bind_grid(grid* g){
+	bound = g;
+}
+
+void spatial::query_radius(const std::vector<std::shared_ptr<entities::entity>>& entities, Vector2 centre, float radius,
+	std::vector<entities::entity*>& found){
+	PROFILE_ZONE("spatial_query");
+	if (bound != nullptr) {
+		if (not bound->is_built_for(entities)) {
+			bound->build(entities);
+		}
+		bound->query(centre, radius, found);
+		return;
+	}
+	for (auto& e : entities) {
+		if (e->is_solid() and circle_overlaps(centre, radius, e->get_rectangle())) {
+			found.push_back(e.get());
+		}
+	}
+}
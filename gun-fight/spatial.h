@@ -0,0 +1,87 @@
+/*****************************************************************//**
+ * \file   spatial.h
+ * \brief  header file for the spatial grid, answers which entities lie within
+ * a radius without visiting every entity. The screen is cut into square cells
+ * of config::SPATIAL_CELL_SIZE, each entity is binned into every cell its
+ * rectangle covers, and a query only tests the entities in the cells under the
+ * circle's bounds.
+ *
+ * The grid is built at most once a frame, by the first query after the game
+ * manager binds it, so a frame without explosions never builds it and chained
+ * explosions share one build
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "entities.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace spatial {
+	/**  counters since the grid was last bound */
+	struct grid_stats {
+		int builds = 0;
+		int queries = 0;
+		int tested = 0; // rectangles tested against a circle
+		int found = 0;
+	};
+
+	/**  true if the circle touches the rectangle, by the distance to its closest point */
+	bool circle_overlaps(Vector2 centre, float radius, const Rectangle& rectangle);
+
+	class grid {
+	public:
+		/**  constructors and destructors */
+		~grid() = default;
+		grid();
+		grid(const grid&) = delete;
+		grid& operator=(const grid&) = delete;
+
+		/**  bin every entity by the cells its rectangle covers */
+		void build(const std::vector<std::shared_ptr<entities::entity>>& entities);
+		/**  the entities are rebinned by the next query, called once a frame */
+		void invalidate();
+		bool is_built_for(const std::vector<std::shared_ptr<entities::entity>>& entities) const;
+		/**  append every entity touching the circle to found, each once */
+		void query(Vector2 centre, float radius, std::vector<entities::entity*>& found);
+		grid_stats get_stats() const;
+	private:
+		int column(float x) const; // clamped to the grid, entities off screen share the edge cells
+		int row(float y) const;
+
+		int columns_;
+		int rows_;
+		std::vector<std::uint32_t> cell_start_; // where each cell's entries begin in cells_, one past the end for the last
+		std::vector<std::uint32_t> cells_; // entity indices grouped by cell
+		std::vector<entities::entity*> entities_;
+		std::vector<Rectangle> rectangles_; // taken when built
+		std::vector<std::uint32_t> stamps_; // the last query each entity was found by, an entity spanning cells is found once
+		std::uint32_t stamp_ = 0;
+		const void* source_ = nullptr; // the list the grid was built from
+		std::size_t source_size_ = 0;
+		bool valid_ = false;
+		grid_stats stats_;
+	};
+
+	/**  the grid explosions query on this thread, may be nullptr */
+	grid* bound_grid();
+	void bind_grid(grid* g);
+
+	/**  binds a grid for the lifetime of the scope, it is invalidated so the first query rebuilds it */
+	class grid_scope {
+	public:
+		explicit grid_scope(grid& g) : previous_(bound_grid()) { g.invalidate(); bind_grid(&g); };
+		~grid_scope() { bind_grid(previous_); };
+		grid_scope(const grid_scope&) = delete;
+		grid_scope& operator=(const grid_scope&) = delete;
+	private:
+		grid* previous_;
+	};
+
+	/**  the entities touching the circle, through the bound grid or by testing every entity if none is bound */
+	void query_radius(const std::vector<std::shared_ptr<entities::entity>>& entities, Vector2 centre, float radius,
+		std::vector<entities::entity*>& found);
+}
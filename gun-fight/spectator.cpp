@@ -0,0 +1,420 @@
+/*****************************************************************//**
+ * \file   spectator.cpp
+ * \brief  implementation file for the spectator stream
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "spectator.h"
+#include "resources.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <span>
+#include <string>
+
+namespace {
+	constexpr std::uint16_t MAGIC = 0x4647; // "GF"
+	constexpr std::uint8_t KEYFRAME = 1;
+
+	/**  the sheets the game can send besides the round's, the gunmen and the obstacles */
+	const auto WORLD_SPRITES = std::array<const char*, 7>{
+		config::P1_PATH, config::P2_PATH, archetype::TUMBLEWEED.path, archetype::CACTUS.path,
+		archetype::BARREL.path, archetype::WAGON.path, config::WAGON_UP_PATH };
+
+	/**  the viewer only loads sheets it knows, a packet naming anything else gets nullptr */
+	const char* known_sheet(std::string_view sheet) {
+		for (auto sprites : { std::span<const char* const>(archetype::ROUND_SPRITES), std::span<const char* const>(WORLD_SPRITES) }) {
+			auto it = std::find(sprites.begin(), sprites.end(), sheet);
+			if (it != sprites.end()) { return *it; }
+		}
+		return nullptr;
+	}
+
+	/**  the fields of an updated entity */
+	enum field : std::uint8_t {
+		POSITION = 1,
+		FRAME = 2,
+		HEALTH = 4
+	};
+
+	/**  appends little endian values to a packet */
+	struct writer {
+		std::vector<std::uint8_t>& out;
+		void u8(std::uint8_t v) { out.push_back(v); }
+		void u16(std::uint16_t v) { u8(std::uint8_t(v)); u8(std::uint8_t(v >> 8)); }
+		void u32(std::uint32_t v) { u16(std::uint16_t(v)); u16(std::uint16_t(v >> 16)); }
+	};
+
+	/**  reads little endian values, a read past the end leaves ok false */
+	struct reader {
+		const std::uint8_t* data;
+		std::size_t size;
+		std::size_t at = 0;
+		bool ok = true;
+		std::uint8_t u8() {
+			if (at >= size) { ok = false; return 0; }
+			return data[at++];
+		}
+		std::uint16_t u16() { auto low = u8(); return std::uint16_t(low | (u8() << 8)); }
+		std::uint32_t u32() { auto low = u16(); return low | (std::uint32_t(u16()) << 16); }
+	};
+
+	std::int16_t quantise(float v) {
+		return std::int16_t(std::clamp(std::lround(v), -32768L, 32767L));
+	}
+
+	std::uint16_t to_u16(float v) {
+		return std::uint16_t(std::clamp(v, 0.0f, 65535.0f));
+	}
+
+	std::uint8_t changed_fields(const spectator::sprite_state& a, const spectator::sprite_state& b) {
+		auto fields = std::uint8_t{ 0 };
+		if (a.x != b.x or a.y != b.y) { fields |= POSITION; }
+		if (a.sprite != b.sprite or a.layer != b.layer or a.source_x != b.source_x or a.source_y != b.source_y
+			or a.source_width != b.source_width or a.source_height != b.source_height) {
+			fields |= FRAME;
+		}
+		if (a.health != b.health) { fields |= HEALTH; }
+		return fields;
+	}
+
+	void write_fields(writer& w, std::uint8_t fields, const spectator::sprite_state& s) {
+		if (fields & POSITION) {
+			w.u16(std::uint16_t(s.x));
+			w.u16(std::uint16_t(s.y));
+		}
+		if (fields & FRAME) {
+			w.u8(s.sprite);
+			w.u8(s.layer);
+			w.u16(s.source_x);
+			w.u16(s.source_y);
+			w.u16(s.source_width);
+			w.u16(s.source_height);
+		}
+		if (fields & HEALTH) {
+			w.u8(std::uint8_t(s.health));
+		}
+	}
+
+	void read_fields(reader& r, std::uint8_t fields, spectator::sprite_state& s) {
+		if (fields & POSITION) {
+			s.x = std::int16_t(r.u16());
+			s.y = std::int16_t(r.u16());
+		}
+		if (fields & FRAME) {
+			s.sprite = r.u8();
+			s.layer = r.u8();
+			s.source_x = r.u16();
+			s.source_y = r.u16();
+			s.source_width = r.u16();
+			s.source_height = r.u16();
+		}
+		if (fields & HEALTH) {
+			s.health = std::int8_t(r.u8());
+		}
+	}
+}
+
+/**  encoder */
+spectator::encoder::encoder(){
+	packet_.reserve(config::SPECTATOR_MAX_PACKET);
+	updated_.reserve(config::SPECTATOR_MAX_PACKET);
+}
+
+bool spectator::encoder::encode(const std::vector<std::shared_ptr<entities::entity>>& entities, const match_state& match){
+	auto keyframe = force_keyframe_ or ticks_since_keyframe_ >= config::SPECTATOR_KEYFRAME_INTERVAL;
+	if (not write(entities, match, keyframe)) {
+		++stats_.overflows;
+		reset();
+		return false;
+	}
+	if (keyframe) {
+		++stats_.keyframes;
+		ticks_since_keyframe_ = 0;
+		force_keyframe_ = false;
+	}
+	else {
+		++stats_.deltas;
+		++ticks_since_keyframe_;
+	}
+	stats_.last_packet = packet_.size();
+	return true;
+}
+
+void spectator::encoder::request_keyframe(){
+	force_keyframe_ = true;
+}
+
+void spectator::encoder::reset(){
+	sent_.clear();
+	free_ids_.clear();
+	next_id_ = 0;
+	force_keyframe_ = true;
+}
+
+const std::vector<std::uint8_t>& spectator::encoder::get_packet() const {
+	return packet_;
+}
+
+spectator::broadcast_stats spectator::encoder::get_stats() const {
+	return stats_;
+}
+
+std::uint8_t spectator::encoder::sprite_index(const char* path){
+	auto sheet = std::string_view(path == nullptr ? "" : path);
+	auto it = std::find(sprites_.begin(), sprites_.end(), sheet);
+	if (it != sprites_.end()) {
+		return static_cast<std::uint8_t>(it - sprites_.begin());
+	}
+	if (sprites_.size() > UINT8_MAX) { return 0; }
+	sprites_.emplace_back(sheet);
+	return static_cast<std::uint8_t>(sprites_.size() - 1);
+}
+
+/**  compare every entity with what was sent last tick, then write the packet.
+ * false if it does not fit, the caller then starts again from a keyframe */
+bool spectator::encoder::write(const std::vector<std::shared_ptr<entities::entity>>& entities, const match_state& match, bool keyframe){
+	++sequence_;
+	updated_.clear();
+	auto u = writer{ updated_ };
+	auto updated = std::uint16_t{ 0 };
+	for (auto& e : entities) {
+		auto anim = e->get_animation();
+		auto frame = anim.get_current_frame();
+		auto gunman = dynamic_cast<const entities::gunman*>(e.get());
+		auto state = sprite_state{
+			sprite_index(anim.get_path()), static_cast<std::uint8_t>(e->get_layer()),
+			to_u16(frame.x), to_u16(frame.y), to_u16(frame.width), to_u16(frame.height),
+			quantise(e->get_x()), quantise(e->get_y()),
+			gunman != nullptr ? std::int8_t(gunman->get_health()) : std::int8_t{ 0 } };
+
+		auto [it, added] = sent_.try_emplace(e.get());
+		auto& t = it->second;
+		auto fields = std::uint8_t(POSITION | FRAME | (gunman != nullptr ? HEALTH : 0));
+		if (added) {
+			if (free_ids_.empty()) { t.id = next_id_++; }
+			else { t.id = free_ids_.back(); free_ids_.pop_back(); }
+		}
+		else if (not keyframe) {
+			fields = changed_fields(t.state, state);
+		}
+		t.state = state;
+		t.seen = sequence_;
+		if (fields == 0) { continue; }
+		u.u16(t.id);
+		u.u8(fields);
+		write_fields(u, fields, state);
+		++updated;
+	}
+
+	/**  entities that were not seen this tick are gone, a keyframe replaces the whole world anyway */
+	removed_.clear();
+	auto r = writer{ removed_ };
+	auto removed = std::uint16_t{ 0 };
+	std::erase_if(sent_, [&](auto& entry) {
+		if (entry.second.seen == sequence_) { return false; }
+		if (not keyframe) {
+			r.u16(entry.second.id);
+			++removed;
+		}
+		free_ids_.push_back(entry.second.id);
+		return true;
+	});
+
+	packet_.clear();
+	auto w = writer{ packet_ };
+	w.u16(MAGIC);
+	w.u8(keyframe ? KEYFRAME : 0);
+	w.u32(sequence_);
+	w.u8(std::uint8_t(match.score_1));
+	w.u8(std::uint8_t(match.score_2));
+	w.u16(std::uint16_t(match.round));
+	/**  sheets new since the last packet, or all of them for a keyframe */
+	auto first = keyframe ? std::size_t{ 0 } : sprites_sent_;
+	w.u8(std::uint8_t(sprites_.size() - first));
+	for (auto i = first; i < sprites_.size(); ++i) {
+		auto length = std::min<std::size_t>(sprites_[i].size(), UINT8_MAX);
+		w.u8(std::uint8_t(i));
+		w.u8(std::uint8_t(length));
+		packet_.insert(packet_.end(), sprites_[i].begin(), sprites_[i].begin() + length);
+	}
+	sprites_sent_ = sprites_.size();
+	w.u16(removed);
+	packet_.insert(packet_.end(), removed_.begin(), removed_.end());
+	w.u16(updated);
+	packet_.insert(packet_.end(), updated_.begin(), updated_.end());
+	return packet_.size() <= config::SPECTATOR_MAX_PACKET;
+}
+
+/**  broadcaster */
+spectator::broadcaster::broadcaster(std::uint16_t port){
+	if (socket_.open(port)) {
+		TraceLog(LOG_INFO, "SPECTATOR: broadcasting on port %i", port);
+	}
+	else {
+		TraceLog(LOG_WARNING, "SPECTATOR: could not open port %i", port);
+	}
+}
+
+bool spectator::broadcaster::is_open() const {
+	return socket_.is_open();
+}
+
+void spectator::broadcaster::broadcast(const std::vector<std::shared_ptr<entities::entity>>& entities, const match_state& match){
+	if (not is_open()) { return; }
+	accept_subscribers();
+	/**  nobody to send to, start again from a keyframe when somebody subscribes */
+	if (subscribers_.empty()) {
+		encoder_.reset();
+		return;
+	}
+	if (not encoder_.encode(entities, match)) { return; }
+	/**  the same bytes go to every viewer */
+	auto& packet = encoder_.get_packet();
+	for (auto& s : subscribers_) {
+		socket_.send(s.address, packet.data(), packet.size());
+	}
+}
+
+spectator::broadcast_stats spectator::broadcaster::get_stats() const {
+	auto stats = encoder_.get_stats();
+	stats.subscribers = static_cast<int>(subscribers_.size());
+	return stats;
+}
+
+/**  any datagram subscribes its sender, viewers that stop sending are dropped */
+void spectator::broadcaster::accept_subscribers(){
+	auto now = GetTime();
+	auto hello = std::array<std::uint8_t, 16>{};
+	auto from = net::endpoint{};
+	while (socket_.receive(hello.data(), hello.size(), from) > 0) {
+		auto it = std::find_if(subscribers_.begin(), subscribers_.end(), [&from](auto& s) { return s.address == from; });
+		if (it != subscribers_.end()) {
+			it->last_hello = now;
+		}
+		else if (subscribers_.size() < config::SPECTATOR_MAX_SUBSCRIBERS) {
+			subscribers_.push_back({ from, now });
+			encoder_.request_keyframe();
+		}
+	}
+	std::erase_if(subscribers_, [now](auto& s) { return now - s.last_hello > config::SPECTATOR_TIMEOUT; });
+}
+
+/**  viewer */
+spectator::viewer::viewer(net::endpoint game)
+	: game_(game), buffer_(config::SPECTATOR_MAX_PACKET) {
+	if (not socket_.open(0)) {
+		TraceLog(LOG_WARNING, "SPECTATOR: could not open a socket");
+	}
+}
+
+bool spectator::viewer::is_open() const {
+	return socket_.is_open();
+}
+
+bool spectator::viewer::send(const std::uint8_t* data, std::size_t size){
+	return socket_.send(game_, data, size);
+}
+
+void spectator::viewer::poll(){
+	auto now = GetTime();
+	if (now - last_hello_ >= config::SPECTATOR_HELLO_INTERVAL) {
+		auto hello = std::uint8_t{ 1 };
+		socket_.send(game_, &hello, 1);
+		last_hello_ = now;
+	}
+	auto from = net::endpoint{};
+	while (auto size = socket_.receive(buffer_.data(), buffer_.size(), from)) {
+		if (from == game_) {
+			apply(buffer_.data(), size);
+		}
+	}
+}
+
+/**  apply a packet to the world, a lost or broken packet waits for the next keyframe */
+bool spectator::viewer::apply(const std::uint8_t* data, std::size_t size){
+	auto r = reader{ data, size };
+	if (r.u16() != MAGIC) { return false; }
+	auto keyframe = (r.u8() & KEYFRAME) != 0;
+	auto sequence = r.u32();
+	if (keyframe) {
+		world_.clear();
+		synced_ = true;
+	}
+	else if (not synced_ or sequence != sequence_ + 1) {
+		synced_ = false;
+		return false;
+	}
+	sequence_ = sequence;
+	match_.score_1 = r.u8();
+	match_.score_2 = r.u8();
+	match_.round = r.u16();
+
+	auto sheets = r.u8();
+	for (auto i = 0; i < sheets and r.ok; ++i) {
+		auto index = r.u8();
+		auto length = r.u8();
+		if (r.at + length > r.size) { r.ok = false; break; }
+		if (index >= sprites_.size()) { sprites_.resize(index + 1); }
+		auto sheet = std::string_view(reinterpret_cast<const char*>(r.data + r.at), length);
+		sprites_[index] = known_sheet(sheet);
+		if (sprites_[index] == nullptr) {
+			TraceLog(LOG_WARNING, "SPECTATOR: the game sent an unknown sheet %.*s, it is not drawn", int(length), sheet.data());
+		}
+		r.at += length;
+	}
+	auto removed = r.u16();
+	for (auto i = 0; i < removed and r.ok; ++i) {
+		world_.erase(r.u16());
+	}
+	auto updated = r.u16();
+	for (auto i = 0; i < updated and r.ok; ++i) {
+		auto id = r.u16();
+		auto fields = r.u8();
+		read_fields(r, fields, world_[id]);
+	}
+	synced_ = r.ok;
+	return r.ok;
+}
+
+/**  queue the world in the same layers as the game, then the scores and health over it */
+void spectator::viewer::draw(render::render_queue& queue){
+	auto background = resources::load_texture(config::BACKGROUND_PATH);
+	queue.submit(render::BACKGROUND, 0.0, background,
+		Rectangle{ 0.0, 0.0, config::PLAYABLE_WIDTH, config::PLAYABLE_HEIGHT }, Vector2{ config::PLAYABLE_X, config::PLAYABLE_Y });
+	for (auto& [id, s] : world_) {
+		if (s.sprite >= sprites_.size() or sprites_[s.sprite] == nullptr) { continue; }
+		auto sheet = resources::load_texture(sprites_[s.sprite]);
+		auto source = Rectangle{ float(s.source_x), float(s.source_y), float(s.source_width), float(s.source_height) };
+		queue.submit(s.layer, float(s.y + s.source_height), sheet, source, Vector2{ float(s.x), float(s.y) });
+	}
+	queue.flush();
+
+	auto scores = std::to_string(match_.score_1) + " - " + std::to_string(match_.score_2) + "   round " + std::to_string(match_.round);
+	DrawText(scores.c_str(), config::SCREEN_WIDTH_HALF - MeasureText(scores.c_str(), 20) / 2, 15, 20, RAYWHITE);
+	for (auto& [id, s] : world_) {
+		if (s.health <= 0) { continue; }
+		DrawText(std::to_string(s.health).c_str(), s.x + s.source_width / 2, s.y - 20, 20, RAYWHITE);
+	}
+	if (not synced_) {
+		DrawText("waiting for the game...", 20, config::SCREEN_HEIGHT - 40, 20, RAYWHITE);
+	}
+}
+
+const spectator::match_state& spectator::viewer::get_match() const {
+	return match_;
+}
+
+void spectator::run_viewer(net::endpoint game){
+	auto view = viewer(game);
+	auto queue = render::render_queue();
+	while (not WindowShouldClose() and view.is_open()) {
+		view.poll();
+		BeginDrawing();
+		ClearBackground(BLACK);
+		view.draw(queue);
+		EndDrawing();
+	}
+}
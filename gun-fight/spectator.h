@@ -0,0 +1,166 @@
+/*****************************************************************//**
+ * \file   spectator.h
+ * \brief  header file for the spectator stream. The game broadcasts its world
+ * state once per tick over UDP so extra screens can watch a match without
+ * running the simulation. A viewer subscribes by sending any datagram to the
+ * game's port, and keeps resending it to stay subscribed.
+ *
+ * Each packet is a delta against the previous tick, only entities whose
+ * position, frame or health changed are written, with positions quantised to
+ * whole pixels. Every config::SPECTATOR_KEYFRAME_INTERVAL ticks, and whenever
+ * a viewer joins, a keyframe holds the whole world instead. A viewer that
+ * misses a packet ignores deltas until the next keyframe.
+ * A packet is encoded once and the same bytes are sent to every viewer, so the
+ * encode cost and the bytes per viewer do not grow with the number of viewers.
+ *
+ * wire format, little endian:
+ *  header   u16 magic, u8 flags (1 = keyframe), u32 sequence, u8 score 1, u8 score 2, u16 round
+ *  sprites  u8 count, then u8 index, u8 length, the sheet path. Sheets new this tick, all of them in keyframes
+ *  removed  u16 count, then u16 id. Empty in keyframes
+ *  updated  u16 count, then u16 id, u8 fields, then the fields present:
+ *           POSITION i16 x, i16 y
+ *           FRAME    u8 sprite, u8 layer, u16 source x, y, width, height
+ *           HEALTH   i8 health, gunmen only
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "raylib.h"
+#include "entities.h"
+#include "net.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace spectator {
+	/**  one entity as the viewer draws it */
+	struct sprite_state {
+		std::uint8_t sprite = 0; // index into the sheet paths
+		std::uint8_t layer = 0;
+		std::uint16_t source_x = 0;
+		std::uint16_t source_y = 0;
+		std::uint16_t source_width = 0;
+		std::uint16_t source_height = 0;
+		std::int16_t x = 0;
+		std::int16_t y = 0;
+		std::int8_t health = 0;
+	};
+
+	/**  scores and round shown by the viewer */
+	struct match_state {
+		int score_1 = 0;
+		int score_2 = 0;
+		int round = 0;
+	};
+
+	struct broadcast_stats {
+		int subscribers = 0;
+		std::size_t last_packet = 0; // bytes
+		int keyframes = 0;
+		int deltas = 0;
+		int overflows = 0; // ticks not sent because the world did not fit in a packet
+	};
+
+	/**  turns a world into packets, each one a delta against the last */
+	class encoder {
+	public:
+		/**  constructors and destructors */
+		~encoder() = default;
+		encoder();
+		encoder(const encoder&) = delete;
+		encoder& operator=(const encoder&) = delete;
+
+		/**  encode this tick into the packet, false if the world did not fit */
+		bool encode(const std::vector<std::shared_ptr<entities::entity>>& entities, const match_state& match);
+		void request_keyframe(); // the next packet holds the whole world, for a new viewer
+		void reset(); // forget what was sent, nobody is watching
+		const std::vector<std::uint8_t>& get_packet() const;
+		broadcast_stats get_stats() const;
+	private:
+		struct tracked {
+			std::uint16_t id;
+			sprite_state state;
+			std::uint32_t seen; // the last sequence the entity was in the world, older entries have been removed
+		};
+
+		std::uint8_t sprite_index(const char* path);
+		bool write(const std::vector<std::shared_ptr<entities::entity>>& entities, const match_state& match, bool keyframe);
+
+		/**  state sent last tick, keyed by entity. An address freed and reused by a
+		 * new entity in the same tick reads as a change to every field, so it is still drawn right */
+		std::unordered_map<const entities::entity*, tracked> sent_;
+		std::vector<std::uint16_t> free_ids_;
+		std::uint16_t next_id_ = 0;
+		std::vector<std::string> sprites_;
+		std::size_t sprites_sent_ = 0; // sheets already announced since the last keyframe
+		std::vector<std::uint8_t> packet_;
+		std::vector<std::uint8_t> removed_; // the sections are built apart then joined behind the sheets
+		std::vector<std::uint8_t> updated_;
+		std::uint32_t sequence_ = 0;
+		int ticks_since_keyframe_ = 0;
+		bool force_keyframe_ = true;
+		broadcast_stats stats_;
+	};
+
+	/**  the game side, owned by the game_manager */
+	class broadcaster {
+	public:
+		/**  constructors and destructors */
+		~broadcaster() = default;
+		explicit broadcaster(std::uint16_t port);
+		broadcaster(const broadcaster&) = delete;
+		broadcaster& operator=(const broadcaster&) = delete;
+
+		bool is_open() const;
+		/**  accept new viewers then send them this tick's changes */
+		void broadcast(const std::vector<std::shared_ptr<entities::entity>>& entities, const match_state& match);
+		broadcast_stats get_stats() const;
+	private:
+		struct subscriber {
+			net::endpoint address;
+			double last_hello;
+		};
+
+		void accept_subscribers();
+
+		net::udp_socket socket_;
+		std::vector<subscriber> subscribers_;
+		encoder encoder_;
+	};
+
+	/**  the viewer side, rebuilds the world from the packets */
+	class viewer {
+	public:
+		/**  constructors and destructors */
+		~viewer() = default;
+		explicit viewer(net::endpoint game);
+		viewer(const viewer&) = delete;
+		viewer& operator=(const viewer&) = delete;
+
+		bool is_open() const;
+		/**  read every waiting packet and resubscribe when due */
+		void poll();
+		/**  send to the game from the socket the packets arrive on, used by clients of the server */
+		bool send(const std::uint8_t* data, std::size_t size);
+		void draw(render::render_queue& queue);
+		const match_state& get_match() const;
+	private:
+		bool apply(const std::uint8_t* data, std::size_t size);
+
+		net::udp_socket socket_;
+		net::endpoint game_;
+		double last_hello_ = -config::SPECTATOR_HELLO_INTERVAL;
+		bool synced_ = false; // false until a keyframe arrives, and after a packet is lost
+		std::uint32_t sequence_ = 0;
+		std::unordered_map<std::uint16_t, sprite_state> world_;
+		std::vector<const char*> sprites_; // the known sheet each index names, nullptr for any other
+		match_state match_;
+		std::vector<std::uint8_t> buffer_;
+	};
+
+	/**  watch a match until the window is closed, the window must be open */
+	void run_viewer(net::endpoint game);
+}
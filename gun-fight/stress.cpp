@@ -0,0 +1,278 @@
+/*****************************************************************//**
+ * \file   stress.cpp
+ * \brief  implementation file for the stress mode
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "stress.h"
+#include "arena.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+
+namespace {
+	const std::array<const char*, stress::NUM_TYPES> TYPE_NAMES = {
+		"tumbleweed", "wagon", "cactus", "barrel", "pickup", "bullet_stream"
+	};
+
+	/**  a lane that a bullet is fired along every stream_interval frames */
+	struct bullet_stream {
+		float y;
+		float direction;
+	};
+
+	/**  keeps the scene at the target count of each type while a ramp runs */
+	class ramp {
+	public:
+		ramp(game_manager& manager, const stress::scenario& s, bool headless)
+			: manager_(manager), scenario_(s), headless_(headless), gen_(s.seed) {
+			manager_.seed(s.seed);
+		};
+
+		/**  runs one step at the given counts, returns false if the window was closed */
+		bool run_step(const std::array<int, stress::NUM_TYPES>& targets, std::vector<double>& frame_ms, int ramping) {
+			for (auto i = 0; i < scenario_.frames_per_step; ++i) {
+				auto start = std::chrono::steady_clock::now();
+				frame(targets);
+				if (not headless_) {
+					if (WindowShouldClose()) { return false; }
+					draw(targets, ramping, frame_ms.empty() ? 0.0 : frame_ms.back());
+				}
+				frame_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+			}
+			return true;
+		}
+
+		/**  back to an empty level before ramping the next type */
+		void reset() {
+			manager_.clear_entities();
+			manager_.revive_players();
+			for (auto& spawned : spawned_) {
+				spawned.clear();
+			}
+			streams_.clear();
+			/**  the weak references above keep their control blocks alive, so they go first */
+			manager_.get_arena().reset();
+			frame_ = 0;
+		}
+
+	private:
+		void frame(const std::array<int, stress::NUM_TYPES>& targets) {
+			auto& input = manager_.get_input();
+			drive_bots(input);
+			input.begin_frame();
+			for (auto id = 1; id <= std::min(scenario_.bots, 2); ++id) {
+				manager_.update_player(static_cast<std::uint8_t>(id));
+			}
+			/**  a bot kill would end the round, keep the same scene going instead */
+			if (manager_.get_player(1).is_dead() or manager_.get_player(2).is_dead()) {
+				manager_.revive_players();
+			}
+			top_up(targets);
+			fire_streams(targets[stress::BULLET_STREAM]);
+			manager_.update_entities();
+			manager_.remove_entities();
+			manager_.animate_entities(1.0f / config::TARGET_FPS);
+			manager_.increment_frame_count();
+			++frame_;
+		}
+
+		void draw(const std::array<int, stress::NUM_TYPES>& targets, int ramping, double last_ms) {
+			BeginDrawing();
+			manager_.draw_game();
+			DrawText(TextFormat("stress: %s x%i  %.2f ms", TYPE_NAMES[ramping], targets[ramping], last_ms),
+				config::PROFILER_OVERLAY_X, config::PROFILER_OVERLAY_Y - 30, 20, RAYWHITE);
+			EndDrawing();
+		}
+
+		/**  bots walk up and down their side, standing still on the frames they fire */
+		void drive_bots(input::input_queue& input) {
+			const std::array<const std::pair<int, int>*, 2> keys = { &config::GUNMAN1_FIRING, &config::GUNMAN2_FIRING };
+			const std::array<std::pair<int, int>, 2> walk = { std::pair{ KEY_W, KEY_S }, std::pair{ KEY_UP, KEY_DOWN } };
+			auto firing = frame_ % config::STRESS_BOT_FIRE_INTERVAL == 0;
+			auto up = (frame_ / config::STRESS_BOT_TURN_INTERVAL) % 2 == 0;
+			for (auto i = 0; i < std::min(scenario_.bots, 2); ++i) {
+				input.hold(walk[i].first, not firing and up);
+				input.hold(walk[i].second, not firing and not up);
+				if (firing) {
+					input.push(keys[i]->first);
+				}
+				if (frame_ % config::STRESS_BOT_RELOAD_INTERVAL == 0) {
+					input.push(keys[i]->second);
+				}
+			}
+		}
+
+		/**  replace entities that were destroyed, expired or picked up */
+		void top_up(const std::array<int, stress::NUM_TYPES>& targets) {
+			for (auto type = 0; type < stress::BULLET_STREAM; ++type) {
+				auto& spawned = spawned_[type];
+				std::erase_if(spawned, [](auto& weak) {
+					auto e = weak.lock();
+					return e == nullptr or e->get_remove();
+					});
+				while (static_cast<int>(spawned.size()) < targets[type]) {
+					auto e = spawn(type, static_cast<int>(spawned.size()));
+					spawned.push_back(e);
+					manager_.add_entity(std::move(e));
+				}
+			}
+		}
+
+		std::shared_ptr<entities::entity> spawn(int type, int index) {
+			auto x = std::uniform_real_distribution<float>(config::OBSTACLE_RANGE_X, config::OBSTACLE_RANGE_X + config::OBSTACLE_RANGE_WIDTH)(gen_);
+			auto y = std::uniform_real_distribution<float>(config::OBSTACLE_RANGE_Y, config::OBSTACLE_RANGE_HEIGHT - archetype::CACTUS.height)(gen_);
+			switch (type) {
+			case stress::TUMBLEWEED:
+				return memory::make_round<entities::tumbleweed>(x, y);
+			case stress::WAGON:
+				return memory::make_round<entities::wagon>(x, y, 0.0, index % 2 == 0 ? archetype::WAGON.speed : -archetype::WAGON.speed);
+			case stress::CACTUS:
+				return memory::make_round<entities::cactus>(x, y);
+			case stress::BARREL:
+				return memory::make_round<entities::barrel>(x, y);
+			default:
+				/**  pickups are spread over the whole playable area */
+				x = std::uniform_real_distribution<float>(config::PLAYABLE_X, config::PLAYABLE_WIDTH - config::ITEM_WIDTH)(gen_);
+				if (index % 3 == 0) { return memory::make_round<entities::health_pickup>(x, y, config::HEALTH_PICKUP_PATH); }
+				if (index % 3 == 1) { return memory::make_round<entities::armour_pickup>(x, y, config::ARMOUR_PICKUP_PATH); }
+				return memory::make_round<entities::ammo_pickup>(x, y, config::AMMO_PICKUP_PATH);
+			}
+		}
+
+		void fire_streams(int count) {
+			while (static_cast<int>(streams_.size()) < count) {
+				auto y = std::uniform_real_distribution<float>(config::PLAYABLE_Y, config::PLAYABLE_HEIGHT - archetype::BULLET.height)(gen_);
+				streams_.push_back(bullet_stream{ y, streams_.size() % 2 == 0 ? 1.0f : -1.0f });
+			}
+			if (frame_ % scenario_.stream_interval != 0) { return; }
+			for (auto& stream : streams_) {
+				if (stream.direction == 1) {
+					manager_.add_entity(memory::make_round<entities::bullet>(config::PLAYABLE_X + 1.0f, stream.y, config::BULLET_LEFT, stream.direction));
+				}
+				else {
+					manager_.add_entity(memory::make_round<entities::bullet>(config::PLAYABLE_WIDTH - archetype::BULLET.width - 1.0f, stream.y, config::BULLET_RIGHT, stream.direction));
+				}
+			}
+		}
+
+		game_manager& manager_;
+		const stress::scenario& scenario_;
+		bool headless_;
+		std::mt19937 gen_;
+		std::array<std::vector<std::weak_ptr<entities::entity>>, stress::BULLET_STREAM> spawned_;
+		std::vector<bullet_stream> streams_;
+		int frame_ = 0;
+	};
+
+	double percentile(std::vector<double> times, double p) {
+		if (times.empty()) { return 0.0; }
+		auto n = static_cast<std::size_t>(p * (times.size() - 1));
+		std::nth_element(times.begin(), times.begin() + n, times.end());
+		return times[n];
+	}
+}
+
+std::optional<stress::scenario> stress::load_scenario(const char* path){
+	auto file = std::ifstream(path);
+	if (not file) {
+		TraceLog(LOG_WARNING, "STRESS: could not open scenario %s", path);
+		return std::nullopt;
+	}
+	auto s = scenario{};
+	auto line = std::string{};
+	auto line_num = 0;
+	while (std::getline(file, line)) {
+		++line_num;
+		line = line.substr(0, line.find('#'));
+		auto fields = std::istringstream(line);
+		auto key = std::string{};
+		if (not (fields >> key)) { continue; }
+
+		auto type = std::find(TYPE_NAMES.begin(), TYPE_NAMES.end(), key);
+		auto ok = true;
+		if (type != TYPE_NAMES.end()) {
+			auto index = std::distance(TYPE_NAMES.begin(), type);
+			ok = static_cast<bool>(fields >> s.start[index] >> s.step[index]);
+		}
+		else if (key == "bots") { ok = static_cast<bool>(fields >> s.bots); }
+		else if (key == "budget_ms") { ok = static_cast<bool>(fields >> s.budget_ms); }
+		else if (key == "frames_per_step") { ok = static_cast<bool>(fields >> s.frames_per_step); }
+		else if (key == "max_steps") { ok = static_cast<bool>(fields >> s.max_steps); }
+		else if (key == "stream_interval") { ok = static_cast<bool>(fields >> s.stream_interval); }
+		else if (key == "seed") { ok = static_cast<bool>(fields >> s.seed); }
+		else { ok = false; }
+
+		if (not ok) {
+			TraceLog(LOG_WARNING, "STRESS: %s line %i, could not read '%s'", path, line_num, line.c_str());
+			return std::nullopt;
+		}
+	}
+	s.frames_per_step = std::max(s.frames_per_step, 1);
+	s.stream_interval = std::max(s.stream_interval, 1);
+	return s;
+}
+
+stress::report stress::run(game_manager& manager, const scenario& s, bool headless){
+	auto r = report{};
+	r.histogram.assign(static_cast<std::size_t>(std::ceil(s.budget_ms * 2)) + 1, 0);
+	auto runner = ramp(manager, s, headless);
+	auto scope = memory::arena_scope(manager.get_arena());
+
+	for (auto type = 0; type < NUM_TYPES; ++type) {
+		if (s.step[type] <= 0) { continue; }
+		runner.reset();
+		auto targets = s.start;
+		for (auto step = 0; step <= s.max_steps; ++step) {
+			targets[type] = s.start[type] + step * s.step[type];
+			auto frame_ms = std::vector<double>{};
+			if (not runner.run_step(targets, frame_ms, type)) {
+				return r;
+			}
+			for (auto ms : frame_ms) {
+				auto bucket = std::min(static_cast<std::size_t>(ms), r.histogram.size() - 1);
+				++r.histogram[bucket];
+			}
+			r.frames += static_cast<int>(frame_ms.size());
+
+			auto p95 = percentile(frame_ms, 0.95);
+			if (p95 > s.budget_ms) {
+				r.types[type].exceeded = true;
+				break;
+			}
+			r.types[type].sustainable = targets[type];
+			r.types[type].p95_ms = p95;
+		}
+	}
+	runner.reset();
+	return r;
+}
+
+std::string stress::format_report(const scenario& s, const report& r){
+	auto out = std::ostringstream{};
+	out << "stress report\n";
+	out << "budget " << s.budget_ms << " ms (95th percentile), " << s.frames_per_step << " frames per step, "
+		<< r.frames << " frames\n\n";
+	out << "type\tsustainable\tp95_ms\n";
+	for (auto type = 0; type < NUM_TYPES; ++type) {
+		if (s.step[type] <= 0) { continue; }
+		auto& t = r.types[type];
+		out << TYPE_NAMES[type] << "\t" << (t.exceeded ? "" : ">=") << t.sustainable << "\t" << t.p95_ms << "\n";
+	}
+
+	out << "\nframe time histogram\nms\tframes\n";
+	auto most = std::max(1, *std::max_element(r.histogram.begin(), r.histogram.end()));
+	/**  empty buckets above the slowest frame are left out */
+	auto last = r.histogram.size();
+	while (last > 1 and r.histogram[last - 1] == 0) { --last; }
+	for (std::size_t i = 0; i < last; ++i) {
+		auto label = i + 1 < r.histogram.size() ? std::to_string(i) + "-" + std::to_string(i + 1) : std::to_string(i) + "+";
+		out << label << "\t" << r.histogram[i] << "\t" << std::string(r.histogram[i] * 50 / most, '#') << "\n";
+	}
+	return out.str();
+}
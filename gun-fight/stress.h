@@ -0,0 +1,73 @@
+/*****************************************************************//**
+ * \file   stress.h
+ * \brief  header file for the stress mode. A scenario file lists, for each
+ * entity type, how many to start with and how many to add at each ramp step.
+ * Each type is ramped in turn, holding the others at their starting counts,
+ * until the frame time goes over the budget. The report gives the largest
+ * count of each type that stayed within the budget and a histogram of every
+ * frame time measured.
+ *
+ * scenario files are plain text, one setting per line, # starts a comment
+ *   <type> <start> <step>    type is tumbleweed, wagon, cactus, barrel, pickup or bullet_stream
+ *   bots <0-2>               players controlled by bots that walk, fire and reload, player 1 first.
+ *                            the other players stand still and are not updated
+ *   budget_ms <ms>           frame time budget, compared to the 95th percentile of each step
+ *   frames_per_step <n>
+ *   max_steps <n>
+ *   stream_interval <n>      frames between bullets in a stream
+ *   seed <n>
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include "game_manager.h"
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace stress {
+	enum entity_type : int {
+		TUMBLEWEED = 0,
+		WAGON = 1,
+		CACTUS = 2,
+		BARREL = 3,
+		PICKUP = 4,
+		BULLET_STREAM = 5,
+		NUM_TYPES = 6
+	};
+
+	struct scenario {
+		std::array<int, NUM_TYPES> start = {};
+		std::array<int, NUM_TYPES> step = {};
+		int bots = 0;
+		double budget_ms = 1000.0 / config::TARGET_FPS;
+		int frames_per_step = 120;
+		int max_steps = 100;
+		int stream_interval = 10;
+		unsigned int seed = 1;
+	};
+
+	/**  the largest count of a type that stayed within budget */
+	struct type_result {
+		int sustainable = 0;
+		bool exceeded = false; // false if the ramp ended before going over the budget
+		double p95_ms = 0.0; // at the sustainable count
+	};
+
+	struct report {
+		std::array<type_result, NUM_TYPES> types = {};
+		std::vector<int> histogram; // frames per millisecond of frame time, the last bucket is everything over
+		int frames = 0;
+	};
+
+	/**  reads a scenario file, returns nothing if it cannot be opened or has an unknown setting */
+	std::optional<scenario> load_scenario(const char* path);
+
+	/**  ramps every type, drawing each frame unless headless. Stops early if the window is closed */
+	report run(game_manager& manager, const scenario& s, bool headless);
+
+	/**  the report as text */
+	std::string format_report(const scenario& s, const report& r);
+}
@@ -0,0 +1,55 @@
+/*****************************************************************//**
+ * \file   triple_buffer.h
+ * \brief  header file for a lock-free triple buffer, hands whole values from
+ * one writing thread to one reading thread without either waiting. The writer
+ * fills the back slot and publishes it by swapping it with the middle one,
+ * the reader takes the middle slot whenever a newer one has been published.
+ * Neither side ever touches the slot the other is using, so the writer can
+ * run ahead of the reader, or behind it, and the reader always has the
+ * latest complete value to hand
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include <array>
+#include <atomic>
+
+namespace render {
+	template<typename T>
+	class triple_buffer {
+	public:
+		/**  constructors and destructors */
+		~triple_buffer() = default;
+		triple_buffer() = default;
+		triple_buffer(const triple_buffer&) = delete;
+		triple_buffer& operator=(const triple_buffer&) = delete;
+
+		/**  writer, fill the back slot then publish it. The slot given back keeps whatever it
+		 * held, so its storage can be reused */
+		T& back() {
+			return slots_[back_];
+		}
+		void publish() {
+			back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+		}
+
+		/**  reader, the most recently published value. The same one again if nothing has been
+		 * published since, it stays the reader's until the next call */
+		T& latest() {
+			if (middle_.load(std::memory_order_relaxed) & FRESH) {
+				front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+			}
+			return slots_[front_];
+		}
+	private:
+		/**  the middle slot's index, with a bit set while the reader has not seen it */
+		static constexpr unsigned int INDEX = 3;
+		static constexpr unsigned int FRESH = 4;
+
+		std::array<T, 3> slots_{};
+		unsigned int back_ = 0; // only the writer uses it
+		alignas(64) std::atomic<unsigned int> middle_ = 1;
+		alignas(64) unsigned int front_ = 2; // only the reader uses it
+	};
+}
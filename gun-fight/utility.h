@@ -10,18 +10,39 @@
 #include <type_traits>
 #include "entities.h"
 namespace util{
+	/**  the generator bound to this thread, nullptr when none is */
+	inline std::mt19937*& bound_generator() {
+		thread_local std::mt19937* bound = nullptr;
+		return bound;
+	}
+
+	/**  the bound generator, a game binds its own so matches on other threads never
+	 * share one. Otherwise each thread has a generator of its own */
+	inline std::mt19937& generator() {
+		thread_local std::mt19937 own(std::random_device{}());
+		auto bound = bound_generator();
+		return bound != nullptr ? *bound : own;
+	}
+
+	/**  binds a generator for the lifetime of the scope */
+	class generator_scope {
+	public:
+		explicit generator_scope(std::mt19937& gen) : previous_(bound_generator()) { bound_generator() = &gen; };
+		~generator_scope() { bound_generator() = previous_; };
+		generator_scope(const generator_scope&) = delete;
+		generator_scope& operator=(const generator_scope&) = delete;
+	private:
+		std::mt19937* previous_;
+	};
+
 	template<typename N>
 	inline N generate_random_num(N min, N max) {
-		std::random_device rd;
-		std::mt19937 gen(rd());
 		std::uniform_real_distribution<N> dis(min, max);
-		return dis(gen);
+		return dis(generator());
 	}
 	inline int generate_random_int(int min, int max) {
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
 		std::uniform_int_distribution<int> dis(min, max);
-		return dis(gen);
+		return dis(generator());
 	}
 	inline auto cmp = [](auto& a, auto& b) {
 		return Vector2Length(a->get_position()) < Vector2Length(b->get_position());
@@ -6,60 +6,39 @@
  * \date   February 2025
  *********************************************************************/
 #include "entities.h"
+#include "arena.h"
 
 
-/** initialising static variables */
-
-/**  firing when the weapon is loaded */
-bool entities::weapon::loaded_state::fire(entities::weapon* w) {
-	if (w->cooldown_ == 0) {
-		w->state_.reset(nullptr);
-		w->state_ = std::make_unique<unloaded_state>(unloaded_state());
-		w->animation_.next_frame();
-		w->reset_cooldown();
-
+/**  firing when the weapon is loaded and the cooldown has passed */
+bool entities::weapon::fire_round() {
+	if (state_ == weapon_state::LOADED and cooldown_ == 0) {
+		state_ = weapon_state::UNLOADED;
+		animation_.next_frame();
+		reset_cooldown();
 		return true;
 	}
 	return false;
-
-}
-/**  reloading when the weapon is loaded */
-bool entities::weapon::loaded_state::reload(entities::weapon* w) {
-	return true;
-}
-/**  clone the state, for weapon copying */
-std::unique_ptr<entities::weapon::weapon_state> entities::weapon::loaded_state::clone() {
-	return std::make_unique<entities::weapon::loaded_state>(*this);
-}
-
-/**  firing when the weapon is unloaded, unsuccessful */
-bool entities::weapon::unloaded_state::fire(entities::weapon* w) {
-	return false;
 }
-/**  reloading when the weapon is unloaded */
-bool entities::weapon::unloaded_state::reload(entities::weapon* w) {
-	if (w->ammo_ == 0) { 
-		w->animation_.end_frame();
+/**  reloading, a loaded weapon is left as it is */
+bool entities::weapon::load_round() {
+	if (state_ == weapon_state::LOADED) {
+		return true;
+	}
+	if (ammo_ == 0) { 
+		animation_.end_frame();
 		return false; 
 	}
-	w->ammo_ -= 1;
-	w->state_.reset(nullptr);
-	w->state_ = std::make_unique<entities::weapon::loaded_state>(entities::weapon::loaded_state());
-	w->animation_.next_frame();
+	ammo_ -= 1;
+	state_ = weapon_state::LOADED;
+	animation_.next_frame();
 	return true;
 }
 
-std::unique_ptr<entities::weapon::weapon_state> entities::weapon::unloaded_state::clone() {
-	return std::make_unique<entities::weapon::unloaded_state>(*this);
-
-}
-
 int entities::weapon::get_ammo() {
 	return ammo_;
 }
 bool entities::weapon::is_loaded() {
-	auto state = state_.get();
-	return dynamic_cast<entities::weapon::loaded_state*>(state) != nullptr;
+	return state_ == weapon_state::LOADED;
 }
 int  entities::weapon::get_fire_rate() {
 	return fire_rate_;
@@ -81,7 +60,7 @@ entities::weapon& entities::weapon::operator=(const entities::weapon& other) {
 	//TODO call the entity version of the operator=
 	//entities::entity::operator=(other);
 	ammo_ = other.ammo_;
-	state_ = other.state_->clone();
+	state_ = other.state_;
 	fire_rate_ = other.fire_rate_;
 	cooldown_ = other.cooldown_;
 	return *this;
@@ -101,28 +80,21 @@ void entities::weapon::reset_cooldown() {
 /**  create revolver bullets when fired successfully */
 std::shared_ptr<entities::projectile> entities::revolver::create_bullet(float x, float y, int direction) {
 	if (direction == 1) {
-		return std::make_shared<entities::bullet>(entities::bullet(x, y, config::BULLET_LEFT, direction));;
+		return memory::make_round<entities::bullet>(entities::bullet(x, y, config::BULLET_LEFT, direction));
 	}
 	else {
-		return std::make_shared<entities::bullet>(entities::bullet(x, y, config::BULLET_RIGHT, direction));;
+		return memory::make_round<entities::bullet>(entities::bullet(x, y, config::BULLET_RIGHT, direction));
 	}
 }
 bool entities::revolver::fire() {
-	if (state_->fire(this)) {
-		Sound s = LoadSound(config::REVOLVER_FIRE_SOUND);
-		PlaySound(s);
-		return true;
-	}
-	return false;
+	return fire_round();
 }
 bool entities::revolver::reload() {
-	Sound s = LoadSound(config::REVOLVER_RELOAD_SOUND);
-	PlaySound(s);
-	return state_->reload(this);
+	return load_round();
 }
 void entities::revolver::replenish() {
 	ammo_ = config::REVOLVER_AMMO;
-	state_ = std::make_unique<loaded_state>(loaded_state());
+	state_ = weapon_state::LOADED;
 	animation_.default_frame();
 	cooldown_ = 0;
 }
@@ -135,33 +107,25 @@ bool entities::revolver::collide(entity& other) {
 /**  rifle implementation */
 std::shared_ptr<entities::projectile> entities::rifle::create_bullet(float x, float y, int direction){
 	if (direction == 1) {
-		return std::make_shared<entities::rifle_bullet>(entities::rifle_bullet(x, y, config::RIFLE_BULLET_LEFT, direction));
+		return memory::make_round<entities::rifle_bullet>(entities::rifle_bullet(x, y, config::RIFLE_BULLET_LEFT, direction));
 	}
 	else {
-		return std::make_shared<entities::rifle_bullet>(entities::rifle_bullet(x, y, config::RIFLE_BULLET_RIGHT, direction));
+		return memory::make_round<entities::rifle_bullet>(entities::rifle_bullet(x, y, config::RIFLE_BULLET_RIGHT, direction));
 	}
 }
 
 
-// TODO find rifle sounds
 bool entities::rifle::fire(){
-	if (state_->fire(this)) {
-		Sound s = LoadSound(config::REVOLVER_FIRE_SOUND);
-		PlaySound(s);
-		return true;
-	}
-	return false;
+	return fire_round();
 }
 
 bool entities::rifle::reload(){
-	Sound s = LoadSound(config::REVOLVER_RELOAD_SOUND);
-	PlaySound(s);
-	return state_->reload(this);
+	return load_round();
 }
 
 void entities::rifle::replenish(){
 	ammo_ = config::RIFLE_AMMO;
-	state_ = std::make_unique<loaded_state>(loaded_state());
+	state_ = weapon_state::LOADED;
 	animation_.default_frame();
 	cooldown_ = 0;
 }
@@ -173,3 +137,64 @@ bool entities::rifle::update(std::vector<std::shared_ptr<entity>>& entities){
 bool entities::rifle::collide(entity& other){
 	return false;
 }
+/**  dynamite implementation, the stick is thrown as far as the charge reached */
+std::shared_ptr<entities::projectile> entities::dynamite::create_bullet(float x, float y, int direction){
+	auto distance = charge_;
+	charge_ = 0.0f;
+	return memory::make_round<entities::dynamite_stick>(entities::dynamite_stick(x, y, archetype::DYNAMITE_STICK.path, direction, distance));
+}
+
+bool entities::dynamite::fire(){
+	if (not fire_round()) {
+		charge_ = 0.0f;
+		return false;
+	}
+	return true;
+}
+
+bool entities::dynamite::reload(){
+	return load_round();
+}
+
+void entities::dynamite::replenish(){
+	ammo_ = config::DYNAMITE_AMMO;
+	state_ = weapon_state::LOADED;
+	animation_.default_frame();
+	cooldown_ = 0;
+	charge_ = 0.0f;
+}
+
+bool entities::dynamite::update(std::vector<std::shared_ptr<entity>>& entities){
+	return true;
+}
+
+bool entities::dynamite::collide(entity& other){
+	return false;
+}
+
+bool entities::dynamite::can_charge(){
+	return state_ == weapon_state::LOADED and cooldown_ == 0;
+}
+
+/**  a tap throws the minimum distance, holding adds to it up to the maximum */
+void entities::dynamite::charge(){
+	charge_ = charge_ == 0.0f ? config::DYNAMITE_MIN_THROW : std::min(charge_ + config::DYNAMITE_CHARGE_RATE, config::DYNAMITE_MAX_THROW);
+}
+
+bool entities::dynamite::is_charging() const {
+	return charge_ > 0.0f;
+}
+
+/**  the stick stops at the edge of the playable area */
+float entities::dynamite::get_landing_x(int direction) const {
+	return std::clamp(position_.x + charge_ * direction, static_cast<float>(config::PLAYABLE_X),
+		config::PLAYABLE_WIDTH - archetype::DYNAMITE_STICK.width);
+}
+
+/**  the x over the middle of where the stick will land */
+void entities::dynamite::draw_marker(render::render_queue& queue, int direction){
+	if (not is_charging()) { return; }
+	auto pos = Vector2{ get_landing_x(direction) + (archetype::DYNAMITE_STICK.width - config::DYNAMITE_MARKER_SIZE) / 2,
+		position_.y + (archetype::DYNAMITE_STICK.height - config::DYNAMITE_MARKER_SIZE) / 2 };
+	marker_.queue_frame(queue, pos, render::GROUND, pos.y);
+}
@@ -0,0 +1,107 @@
+/*****************************************************************//**
+ * \file   aabb_overlap.cpp
+ * \brief  benchmarks one query rectangle tested against every entity, the
+ * way movement and projectiles test for collisions. The old loop calls
+ * CheckCollisionRecs on each entity's rectangle, the kernels test the packed
+ * rectangles and the batched query also confirms the candidates
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "bench.h"
+#include "collision.h"
+#include <limits>
+#include <random>
+
+namespace {
+	/**  barrels spread over the playable area, the same for every run */
+	std::vector<std::shared_ptr<entities::entity>> scatter(int count) {
+		auto gen = std::mt19937(1234);
+		auto x = std::uniform_real_distribution<float>(config::PLAYABLE_X, config::PLAYABLE_WIDTH - archetype::BARREL.width);
+		auto y = std::uniform_real_distribution<float>(config::PLAYABLE_Y, config::PLAYABLE_HEIGHT - archetype::BARREL.height);
+		auto scene = std::vector<std::shared_ptr<entities::entity>>{};
+		for (auto i = 0; i < count; ++i) {
+			scene.push_back(std::make_shared<entities::barrel>(x(gen), y(gen)));
+		}
+		return scene;
+	}
+
+	/**  a gunman sized query walking across the screen */
+	Rectangle query(long long i) {
+		return Rectangle{ float(i * 37 % config::PLAYABLE_WIDTH), float(config::PLAYABLE_Y + i * 53 % config::PLAYABLE_HEIGHT),
+			config::GUNMAN_WIDTH, config::GUNMAN_HEIGHT };
+	}
+
+	bench::result scalar_loop(int count) {
+		auto scene = scatter(count);
+		auto reps = bench::repeats(count);
+		return bench::measure([] {},
+			[&] {
+				auto hits = 0ll;
+				for (auto i = 0; i < reps; ++i) {
+					auto q = query(i);
+					for (auto& e : scene) {
+						hits += CheckCollisionRecs(q, e->get_rectangle());
+					}
+				}
+				bench::sink = hits;
+			}, reps);
+	}
+
+	/**  the kernel alone over rectangles packed without a margin */
+	bench::result kernel(collision::isa isa, int count) {
+		auto scene = scatter(count);
+		auto padded = (count + collision::LANES - 1) / collision::LANES * collision::LANES;
+		auto left = std::vector<float>(padded, std::numeric_limits<float>::max());
+		auto top = left;
+		auto right = std::vector<float>(padded, std::numeric_limits<float>::lowest());
+		auto bottom = right;
+		for (auto i = 0; i < count; ++i) {
+			auto r = scene[i]->get_rectangle();
+			left[i] = r.x;
+			top[i] = r.y;
+			right[i] = r.x + r.width;
+			bottom[i] = r.y + r.height;
+		}
+		auto mask = std::vector<std::uint64_t>((padded + 63) / 64);
+		auto reps = bench::repeats(count);
+		return bench::measure([] {},
+			[&] {
+				auto hits = 0ll;
+				for (auto i = 0; i < reps; ++i) {
+					collision::overlap_mask(isa, query(i), left.data(), top.data(), right.data(), bottom.data(), padded, mask.data());
+					hits += static_cast<long long>(mask[0]);
+				}
+				bench::sink = hits;
+			}, reps);
+	}
+
+	/**  what the game runs, the best kernel then the candidates confirmed */
+	bench::result batched_query(int count) {
+		auto scene = scatter(count);
+		auto batch = collision::rect_batch();
+		auto scope = collision::batch_scope(batch, scene);
+		auto reps = bench::repeats(count);
+		return bench::measure([] {},
+			[&] {
+				auto hits = 0ll;
+				for (auto i = 0; i < reps; ++i) {
+					collision::for_each_overlap(scene, query(i), [&hits](entities::entity&) {
+						++hits;
+						return true;
+					});
+				}
+				bench::sink = hits;
+			}, reps);
+	}
+}
+
+void bench::add_aabb_benchmarks(std::vector<benchmark>& benchmarks){
+	benchmarks.push_back({ "aabb_scalar_loop", scalar_loop });
+	for (auto isa : { collision::isa::SCALAR, collision::isa::SSE2, collision::isa::AVX2 }) {
+		if (not collision::is_supported(isa)) { continue; }
+		static const char* names[] = { "aabb_kernel_scalar", "aabb_kernel_sse2", "aabb_kernel_avx2" };
+		benchmarks.push_back({ names[static_cast<int>(isa)], [isa](int count) { return kernel(isa, count); } });
+	}
+	benchmarks.push_back({ "aabb_batched_query", batched_query });
+}
@@ -0,0 +1,99 @@
+/*****************************************************************//**
+ * \file   batched_update.cpp
+ * \brief  benchmarks the per archetype batched entity update against the
+ * previous loop, which updated the entities in list order through a virtual
+ * call after a dynamic_cast to skip the gunmen, and the batched update shared
+ * with a job pool
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "bench.h"
+#include "entities.h"
+#include "game_manager.h"
+#include "player.h"
+#include "jobs.h"
+#include <random>
+
+namespace {
+	/**  a shuffled mix of every batched type, the same for every run */
+	std::vector<std::shared_ptr<entities::entity>> mixed_scene(int count) {
+		auto gen = std::mt19937(1234);
+		auto x = std::uniform_real_distribution<float>(config::PLAYABLE_X, config::PLAYABLE_WIDTH - archetype::WAGON.width);
+		auto y = std::uniform_real_distribution<float>(config::PLAYABLE_Y, config::PLAYABLE_HEIGHT - archetype::WAGON.height);
+		auto scene = std::vector<std::shared_ptr<entities::entity>>{};
+		for (auto i = 0; i < count; ++i) {
+			auto pos = Vector2{ x(gen), y(gen) };
+			switch (i % 5) {
+				case 0:
+					scene.push_back(std::make_shared<entities::wagon>(pos.x, pos.y, 0.0, i % 2 == 0 ? archetype::WAGON.speed : -archetype::WAGON.speed));
+					break;
+				case 1:
+					scene.push_back(std::make_shared<entities::tumbleweed>(pos.x, pos.y));
+					break;
+				case 2:
+					scene.push_back(std::make_shared<entities::cactus>(pos.x, pos.y));
+					break;
+				case 3:
+					scene.push_back(std::make_shared<entities::barrel>(pos.x, pos.y));
+					break;
+				default:
+					scene.push_back(std::make_shared<entities::bullet>(pos.x, pos.y, i % 2 == 0 ? config::BULLET_LEFT : config::BULLET_RIGHT, i % 2 == 0 ? 1.0f : -1.0f));
+					break;
+			}
+		}
+		std::shuffle(scene.begin(), scene.end(), gen);
+		return scene;
+	}
+
+	game_manager make_manager() {
+		auto gunman_1 = std::make_shared<entities::gunman>(config::P1_START_X, config::P1_START_Y, config::P1_PATH, 1, 1);
+		auto weapon_1 = std::make_shared<entities::revolver>(0.0, 0.0, config::REVOLVER_PATH);
+		auto gunman_2 = std::make_shared<entities::gunman>(config::P2_START_X, config::P2_START_Y, config::P2_PATH, 1, -1);
+		auto weapon_2 = std::make_shared<entities::revolver>(0.0, 0.0, config::REVOLVER_PATH);
+		return game_manager(
+			player(gunman_1, weapon_1, config::GUNMAN1_MOVEMENT, config::GUNMAN1_FIRING, config::P1_ITEM_KEY, 150, config::P1_WIN_PATH),
+			player(gunman_2, weapon_2, config::GUNMAN2_MOVEMENT, config::GUNMAN2_FIRING, config::P2_ITEM_KEY, config::SCREEN_WIDTH - 150, config::P2_WIN_PATH));
+	}
+
+	/**  one frame of updates, obstacles take damage so the scene is rebuilt before every run */
+	bench::result batched(int count) {
+		auto manager = make_manager();
+		return bench::measure([&] {
+				manager.clear_entities();
+				for (auto& e : mixed_scene(count)) {
+					manager.add_entity(e);
+				}
+			},
+			[&] { manager.update_entities(); }, count);
+	}
+
+	/**  the same frame with a worker on each of the other cores, a single core machine runs it inline */
+	bench::result parallel(int count) {
+		auto workers = jobs::pool();
+		auto scope = jobs::pool_scope(workers);
+		return batched(count);
+	}
+
+	bench::result per_object(int count) {
+		auto scene = std::vector<std::shared_ptr<entities::entity>>{};
+		return bench::measure([&] {
+				scene = mixed_scene(count);
+				scene.push_back(std::make_shared<entities::gunman>(config::P1_START_X, config::P1_START_Y, config::P1_PATH, 1, 1));
+				scene.push_back(std::make_shared<entities::gunman>(config::P2_START_X, config::P2_START_Y, config::P2_PATH, 1, -1));
+			},
+			[&] {
+				for (auto& e : scene) {
+					if (dynamic_cast<entities::gunman*>(e.get()) == nullptr) {
+						bench::sink = bench::sink + e->update(scene);
+					}
+				}
+			}, count);
+	}
+}
+
+void bench::add_batched_update_benchmarks(std::vector<benchmark>& benchmarks){
+	benchmarks.push_back({ "update_entities_per_object", per_object });
+	benchmarks.push_back({ "update_entities_batched", batched });
+	benchmarks.push_back({ "update_entities_parallel", parallel });
+}
@@ -0,0 +1,71 @@
+/*****************************************************************//**
+ * \file   bench.h
+ * \brief  header file for the headless benchmarks. Each benchmark is run
+ * once per entity count, the untimed setup is repeated before every timed
+ * run so state such as positions can be restored
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace bench {
+	/**  entity counts every benchmark is run at */
+	inline const std::vector<int> COUNTS = { 10, 100, 1000, 10000 };
+	/**  each count is timed for at least this long and this many runs */
+	inline const double MIN_SECONDS = 0.25;
+	inline const long long MIN_RUNS = 3;
+	inline const long long MAX_RUNS = 100000;
+
+	/**  timings for one entity count, per operation */
+	struct result {
+		long long runs = 0;
+		double mean_ns = 0.0;
+		double min_ns = 0.0;
+	};
+
+	struct benchmark {
+		const char* name;
+		std::function<result(int count)> run;
+	};
+
+	/**  keeps a value alive so the work that produced it is not optimised away */
+	inline volatile long long sink = 0;
+
+	/**  times run() after each setup(), run() performs ops operations */
+	template<typename setup_fn, typename run_fn>
+	result measure(setup_fn setup, run_fn run, long long ops) {
+		using clock = std::chrono::steady_clock;
+		auto res = result{};
+		auto total = 0.0;
+		while (res.runs < MAX_RUNS and (res.runs < MIN_RUNS or total < MIN_SECONDS * 1e9)) {
+			setup();
+			auto start = clock::now();
+			run();
+			auto ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+			res.min_ns = res.runs == 0 ? ns : std::min(res.min_ns, ns);
+			total += ns;
+			++res.runs;
+		}
+		res.mean_ns = total / res.runs / ops;
+		res.min_ns /= ops;
+		return res;
+	}
+
+	/**  operations per run, small counts are repeated so a run is long enough to time */
+	inline long long repeats(int count) {
+		return std::max(1, 10000 / count);
+	}
+
+	/**  benchmark groups */
+	void add_hot_path_benchmarks(std::vector<benchmark>& benchmarks);
+	void add_batched_update_benchmarks(std::vector<benchmark>& benchmarks);
+	void add_match_benchmarks(std::vector<benchmark>& benchmarks);
+	void add_particle_benchmarks(std::vector<benchmark>& benchmarks);
+	void add_aabb_benchmarks(std::vector<benchmark>& benchmarks);
+	void add_gym_benchmarks(std::vector<benchmark>& benchmarks);
+}
@@ -0,0 +1,45 @@
+/*****************************************************************//**
+ * \file   gym_step.cpp
+ * \brief  benchmarks a vector of training environments stepped in
+ * lockstep across the job pool, with bots that walk and fire. One over the
+ * time per environment step is the steps per second a trainer is fed
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "bench.h"
+#include "gym.h"
+#include <memory>
+
+namespace {
+	/**  environments are a few hundred kilobytes each, large counts step the same ones more times */
+	const std::size_t MAX_ENVIRONMENTS = 256;
+
+	bench::result vector_step(int count) {
+		auto environments = std::min(static_cast<std::size_t>(count), MAX_ENVIRONMENTS);
+		auto steps = (static_cast<std::size_t>(count) + environments - 1) / environments;
+		auto env = gym::vector_env(environments);
+		auto observations = std::vector<float>(environments * gym::AGENTS * gym::OBSERVATION_SIZE);
+		auto rewards = std::vector<float>(environments * gym::AGENTS);
+		auto dones = std::vector<std::uint8_t>(environments);
+		auto actions = std::vector<gym::action>(environments * gym::AGENTS);
+		env.reset(1234, observations.data());
+		auto tick = 0;
+		return bench::measure([] {},
+			[&] {
+				for (std::size_t s = 0; s < steps; ++s) {
+					auto walk = (tick / 30) % 2 == 0 ? server::UP : server::DOWN;
+					auto fire = tick % config::STRESS_BOT_FIRE_INTERVAL == 0 ? server::FIRE : 0;
+					auto reload = tick % config::STRESS_BOT_RELOAD_INTERVAL == 0 ? server::RELOAD : 0;
+					std::fill(actions.begin(), actions.end(), gym::action{ std::uint8_t(walk), std::uint8_t(fire | reload) });
+					env.step(actions.data(), observations.data(), rewards.data(), dones.data());
+					bench::sink = bench::sink + dones[0];
+					++tick;
+				}
+			}, static_cast<long long>(steps * environments));
+	}
+}
+
+void bench::add_gym_benchmarks(std::vector<benchmark>& benchmarks){
+	benchmarks.push_back({ "gym_vector_step", vector_step });
+}
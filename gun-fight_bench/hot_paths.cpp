@@ -0,0 +1,157 @@
+/*****************************************************************//**
+ * \file   hot_paths.cpp
+ * \brief  benchmarks for the per frame hot paths, level generation and the
+ * collision scans, over increasing numbers of entities
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "bench.h"
+#include "entities.h"
+#include "level_builder.h"
+#include "game_manager.h"
+#include "player.h"
+#include <random>
+
+namespace {
+	/**  setup uses a fixed seed so every run places entities in the same positions */
+	std::mt19937 seeded() {
+		return std::mt19937(1234);
+	}
+
+	Vector2 random_position(std::mt19937& gen) {
+		auto x = std::uniform_real_distribution<float>(config::PLAYABLE_X, config::PLAYABLE_WIDTH - archetype::CACTUS.width);
+		auto y = std::uniform_real_distribution<float>(config::PLAYABLE_Y, config::PLAYABLE_HEIGHT - archetype::CACTUS.height);
+		return Vector2{ x(gen), y(gen) };
+	}
+
+	/**  entities of one type scattered over the playable area */
+	template<typename T, typename make_fn>
+	std::vector<std::shared_ptr<entities::entity>> scatter(int count, make_fn make) {
+		auto gen = seeded();
+		auto scattered = std::vector<std::shared_ptr<entities::entity>>{};
+		for (auto i = 0; i < count; ++i) {
+			auto pos = random_position(gen);
+			scattered.push_back(std::make_shared<T>(make(pos, i)));
+		}
+		return scattered;
+	}
+
+	std::vector<Vector2> positions(std::vector<std::shared_ptr<entities::entity>>& scattered) {
+		auto result = std::vector<Vector2>{};
+		for (auto& e : scattered) {
+			result.push_back(e->get_position());
+		}
+		return result;
+	}
+
+	void restore(std::vector<std::shared_ptr<entities::entity>>& scattered, std::vector<Vector2>& start) {
+		for (std::size_t i = 0; i < scattered.size(); ++i) {
+			scattered[i]->set_pos(start[i].x, start[i].y);
+			scattered[i]->set_remove(false);
+		}
+	}
+
+	bench::result can_insert(int count) {
+		auto gen = seeded();
+		auto placed = std::set<std::shared_ptr<entities::entity>, decltype(util::cmp)>{};
+		for (auto i = 0; i < count; ++i) {
+			auto pos = random_position(gen);
+			placed.insert(std::make_shared<entities::cactus>(pos.x, pos.y));
+		}
+		/**  clear of everything, so every obstacle is checked */
+		auto probe = Rectangle{ -1000.0, -1000.0, archetype::CACTUS.width, archetype::CACTUS.height };
+		auto ops = bench::repeats(count);
+		return bench::measure([] {}, [&] {
+			for (auto i = 0; i < ops; ++i) {
+				bench::sink = bench::sink + can_insert_obstacle(probe, placed);
+			}
+			}, ops);
+	}
+
+	/**  the count is the number of obstacles asked for, most are rejected once the range is full */
+	bench::result build_level(int count) {
+		auto built = std::unique_ptr<level::level>{};
+		return bench::measure([&] { built = std::make_unique<level::level>(3, count); },
+			[&] {
+				built->build_level();
+				bench::sink = bench::sink + built->get_level_entities().size();
+			}, 1);
+	}
+
+	bench::result gunman_move(int count) {
+		auto scene = scatter<entities::cactus>(count, [](Vector2 pos, int) { return entities::cactus(pos.x, pos.y); });
+		auto gunman = std::make_shared<entities::gunman>(config::P1_START_X, config::P1_START_Y, config::P1_PATH, 1, 1);
+		scene.push_back(gunman);
+		auto right = Vector2{ 1.0, 0.0 };
+		auto left = Vector2{ -1.0, 0.0 };
+		/**  moves come in pairs so the gunman ends where it started, the time is divided by the moves made */
+		auto pairs = std::max(1LL, bench::repeats(count) / 2);
+		return bench::measure([] {}, [&] {
+			for (auto i = 0LL; i < pairs; ++i) {
+				bench::sink = bench::sink + gunman->move(right, scene);
+				bench::sink = bench::sink + gunman->move(left, scene);
+			}
+			}, 2 * pairs);
+	}
+
+	/**  every bullet is updated once, against all the others */
+	bench::result projectile_update(int count) {
+		auto scene = scatter<entities::bullet>(count, [](Vector2 pos, int i) {
+			auto direction = i % 2 == 0 ? 1.0f : -1.0f;
+			return entities::bullet(pos.x, pos.y, direction == 1 ? config::BULLET_LEFT : config::BULLET_RIGHT, direction); });
+		auto start = positions(scene);
+		return bench::measure([&] { restore(scene, start); }, [&] {
+			for (auto i = 0; i < count; ++i) {
+				bench::sink = bench::sink + scene[i]->update(scene);
+			}
+			}, count);
+	}
+
+	/**  every obstacle moves once, against all the others */
+	template<typename T, typename make_fn>
+	bench::result obstacle_move(int count, make_fn make) {
+		auto scene = scatter<T>(count, make);
+		auto start = positions(scene);
+		return bench::measure([&] { restore(scene, start); }, [&] {
+			for (auto& e : scene) {
+				bench::sink = bench::sink + static_cast<T*>(e.get())->move(scene);
+			}
+			}, count);
+	}
+
+	/**  half of the entities are flagged for removal */
+	bench::result remove_entities(int count) {
+		auto gunman_1 = std::make_shared<entities::gunman>(config::P1_START_X, config::P1_START_Y, config::P1_PATH, 1, 1);
+		auto weapon_1 = std::make_shared<entities::revolver>(0.0, 0.0, config::REVOLVER_PATH);
+		auto gunman_2 = std::make_shared<entities::gunman>(config::P2_START_X, config::P2_START_Y, config::P2_PATH, 1, -1);
+		auto weapon_2 = std::make_shared<entities::revolver>(0.0, 0.0, config::REVOLVER_PATH);
+		auto manager = game_manager(
+			player(gunman_1, weapon_1, config::GUNMAN1_MOVEMENT, config::GUNMAN1_FIRING, config::P1_ITEM_KEY, 150, config::P1_WIN_PATH),
+			player(gunman_2, weapon_2, config::GUNMAN2_MOVEMENT, config::GUNMAN2_FIRING, config::P2_ITEM_KEY, config::SCREEN_WIDTH - 150, config::P2_WIN_PATH));
+		auto scene = scatter<entities::cactus>(count, [](Vector2 pos, int) { return entities::cactus(pos.x, pos.y); });
+		return bench::measure([&] {
+				manager.clear_entities();
+				for (std::size_t i = 0; i < scene.size(); ++i) {
+					scene[i]->set_remove(i % 2 == 0);
+					manager.add_entity(scene[i]);
+				}
+			},
+			[&] { manager.remove_entities(); }, 1);
+	}
+}
+
+void bench::add_hot_path_benchmarks(std::vector<benchmark>& benchmarks){
+	benchmarks.push_back({ "can_insert_obstacle", can_insert });
+	benchmarks.push_back({ "level_build_level", build_level });
+	benchmarks.push_back({ "gunman_move", gunman_move });
+	benchmarks.push_back({ "projectile_update", projectile_update });
+	benchmarks.push_back({ "moveable_obstacle_move", [](int count) {
+		return obstacle_move<entities::wagon>(count, [](Vector2 pos, int i) {
+			return entities::wagon(pos.x, pos.y, 0.0, i % 2 == 0 ? archetype::WAGON.speed : -archetype::WAGON.speed); });
+		} });
+	benchmarks.push_back({ "tumbleweed_move", [](int count) {
+		return obstacle_move<entities::tumbleweed>(count, [](Vector2 pos, int) { return entities::tumbleweed(pos.x, pos.y); });
+		} });
+	benchmarks.push_back({ "game_manager_remove_entities", remove_entities });
+}
@@ -0,0 +1,42 @@
+/*****************************************************************//**
+ * \file   main.cpp
+ * \brief  runs the headless benchmarks. No window or audio device is opened,
+ * textures and sounds are skipped by the resource cache.
+ *
+ * usage: gun-fight_bench [filter], only benchmarks whose name contains the
+ * filter are run. The output is tab separated, one line per benchmark and
+ * count in a fixed order, so runs on different commits can be diffed
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "bench.h"
+#include "resources.h"
+#include <cstdio>
+#include <string>
+
+int main(int argc, char* argv[]) {
+	SetTraceLogLevel(LOG_WARNING);
+	resources::set_headless(true);
+	auto filter = std::string(argc > 1 ? argv[1] : "");
+
+	auto benchmarks = std::vector<bench::benchmark>{};
+	bench::add_hot_path_benchmarks(benchmarks);
+	bench::add_batched_update_benchmarks(benchmarks);
+	bench::add_match_benchmarks(benchmarks);
+	bench::add_particle_benchmarks(benchmarks);
+	bench::add_aabb_benchmarks(benchmarks);
+	bench::add_gym_benchmarks(benchmarks);
+
+	std::printf("# gun-fight benchmarks, nanoseconds per operation\n");
+	std::printf("benchmark\tcount\truns\tmean_ns\tmin_ns\n");
+	for (auto& b : benchmarks) {
+		if (std::string(b.name).find(filter) == std::string::npos) { continue; }
+		for (auto count : bench::COUNTS) {
+			auto res = b.run(count);
+			std::printf("%s\t%d\t%lld\t%.1f\t%.1f\n", b.name, count, res.runs, res.mean_ns, res.min_ns);
+			std::fflush(stdout);
+		}
+	}
+	return 0;
+}
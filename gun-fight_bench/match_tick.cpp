@@ -0,0 +1,42 @@
+/*****************************************************************//**
+ * \file   match_tick.cpp
+ * \brief  benchmarks one tick of a dedicated server match, with both
+ * players driven by bots that walk and fire. The frame time divided by the
+ * time per tick is the number of matches one core sustains at 60 Hz
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "bench.h"
+#include "server.h"
+#include <memory>
+
+namespace {
+	/**  matches are a few hundred kilobytes each, so large counts tick the same matches */
+	const int MAX_MATCHES = 64;
+
+	bench::result match_tick(int count) {
+		auto matches = std::vector<std::unique_ptr<server::match>>{};
+		for (auto i = 0; i < std::min(count, MAX_MATCHES); ++i) {
+			matches.push_back(std::make_unique<server::match>(1234 + i));
+		}
+		auto tick = 0;
+		return bench::measure([] {},
+			[&] {
+				for (auto i = 0; i < count; ++i) {
+					auto& m = *matches[i % matches.size()];
+					auto walk = (tick / 30) % 2 == 0 ? server::UP : server::DOWN;
+					auto fire = tick % config::STRESS_BOT_FIRE_INTERVAL == 0 ? server::FIRE : 0;
+					auto reload = tick % config::STRESS_BOT_RELOAD_INTERVAL == 0 ? server::RELOAD : 0;
+					m.deliver(0, server::input_message{ std::uint8_t(walk), std::uint8_t(fire | reload) }, 0.0);
+					m.deliver(1, server::input_message{ std::uint8_t(walk), std::uint8_t(fire | reload) }, 0.0);
+					m.tick();
+				}
+				++tick;
+			}, count);
+	}
+}
+
+void bench::add_match_benchmarks(std::vector<benchmark>& benchmarks){
+	benchmarks.push_back({ "server_match_tick", match_tick });
+}
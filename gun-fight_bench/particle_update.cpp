@@ -0,0 +1,43 @@
+/*****************************************************************//**
+ * \file   particle_update.cpp
+ * \brief  benchmarks one frame of the particle update, moving every live
+ * particle and removing the expired ones. A full pool of
+ * config::PARTICLE_CAPACITY particles has to update well inside a millisecond
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "bench.h"
+#include "particles.h"
+#include <algorithm>
+#include <memory>
+
+namespace {
+	/**  the frames an explosion's shortest lived particle, 0.3 seconds, outlasts */
+	constexpr long long LIVE_FRAMES = 17;
+
+	/**  explosions fill the pool with a mix of lifetimes, none of which run out within LIVE_FRAMES updates */
+	void fill(particles::pool& pool, int count) {
+		pool.clear();
+		while (pool.size() < static_cast<std::size_t>(count)) {
+			pool.emit(particles::effect::EXPLOSION, Vector2{ config::SCREEN_WIDTH_HALF, config::SCREEN_HEIGHT_HALF }, ORANGE);
+		}
+	}
+
+	bench::result particle_update(int count) {
+		auto pool = std::make_unique<particles::pool>();
+		/**  the pool is refilled before each run and updated no longer than its particles live, so every update moves count of them */
+		auto reps = std::min(bench::repeats(count), LIVE_FRAMES);
+		return bench::measure([&] { fill(*pool, count); },
+			[&] {
+				for (auto i = 0; i < reps; ++i) {
+					pool->update(1.0f / config::TARGET_FPS);
+				}
+				bench::sink = static_cast<long long>(pool->size());
+			}, reps * static_cast<long long>(count));
+	}
+}
+
+void bench::add_particle_benchmarks(std::vector<benchmark>& benchmarks){
+	benchmarks.push_back({ "particle_update", particle_update });
+}
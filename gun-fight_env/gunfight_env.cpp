@@ -0,0 +1,100 @@
+/*****************************************************************//**
+ * \file   gunfight_env.cpp
+ * \brief  implementation file for the C interface to the training
+ * environments
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#include "gunfight_env.h"
+#include "gym.h"
+#include <exception>
+#include <string>
+
+static_assert(sizeof(gym::action) == 2, "actions are passed as two bytes per agent");
+static_assert(GF_AGENTS == gym::AGENTS);
+
+struct gf_env {
+	gym::vector_env environments;
+};
+
+namespace {
+	std::string& last_error() {
+		thread_local std::string error;
+		return error;
+	}
+
+	/**  call from a catch block, keeps what was thrown for gf_last_error */
+	void record_error() {
+		try {
+			throw;
+		}
+		catch (const std::exception& e) {
+			last_error() = e.what();
+		}
+		catch (...) {
+			last_error() = "unknown error";
+		}
+	}
+}
+
+gf_env* gf_env_create(int count, int threads){
+	if (count <= 0 or threads < 0) {
+		last_error() = "count must be positive and threads not negative";
+		return nullptr;
+	}
+	try {
+		SetTraceLogLevel(LOG_WARNING);
+		return new gf_env{ gym::vector_env(static_cast<std::size_t>(count), static_cast<unsigned int>(threads)) };
+	}
+	catch (...) {
+		record_error();
+		return nullptr;
+	}
+}
+
+void gf_env_destroy(gf_env* env){
+	delete env;
+}
+
+int gf_env_count(const gf_env* env){
+	return env != nullptr ? static_cast<int>(env->environments.size()) : 0;
+}
+
+int gf_observation_size(void){
+	return static_cast<int>(gym::OBSERVATION_SIZE);
+}
+
+int gf_env_reset(gf_env* env, uint32_t seed, float* observations){
+	if (env == nullptr or observations == nullptr) {
+		last_error() = "reset needs a handle and an observations array";
+		return GF_INVALID_ARGUMENT;
+	}
+	try {
+		env->environments.reset(seed, observations);
+		return GF_OK;
+	}
+	catch (...) {
+		record_error();
+		return GF_FAILED;
+	}
+}
+
+int gf_env_step(gf_env* env, const uint8_t* actions, float* observations, float* rewards, uint8_t* dones){
+	if (env == nullptr or actions == nullptr or observations == nullptr or rewards == nullptr or dones == nullptr) {
+		last_error() = "step needs a handle and every array";
+		return GF_INVALID_ARGUMENT;
+	}
+	try {
+		env->environments.step(reinterpret_cast<const gym::action*>(actions), observations, rewards, dones);
+		return GF_OK;
+	}
+	catch (...) {
+		record_error();
+		return GF_FAILED;
+	}
+}
+
+const char* gf_last_error(void){
+	return last_error().c_str();
+}
@@ -0,0 +1,67 @@
+/*****************************************************************//**
+ * \file   gunfight_env.h
+ * \brief  C interface to the training environments, for trainers written
+ * in other languages. A handle is a vector of environments stepped in
+ * lockstep, see gym.h in the game for the observation layout, the rewards
+ * and when an episode is done.
+ *
+ * Every array is owned by the caller and laid out environment by
+ * environment, then agent by agent:
+ *   actions       count * GF_AGENTS * 2 bytes, held then pressed as in server.h
+ *   observations  count * GF_AGENTS * gf_observation_size() floats
+ *   rewards       count * GF_AGENTS floats
+ *   dones         count bytes, 1 where the step ended the round
+ *
+ * The environments read their sprites' collision masks from sprites/, so
+ * load the library from the game's directory.
+ *
+ * Nothing thrown inside the game crosses the interface. Create returns NULL
+ * and reset and step return an error code, gf_last_error says what went wrong
+ *
+ * \author raffa
+ * \date   March 2025
+ *********************************************************************/
+#pragma once
+#include <stdint.h>
+
+#ifdef _WIN32
+	#ifdef GUNFIGHT_ENV_EXPORTS
+		#define GF_API __declspec(dllexport)
+	#else
+		#define GF_API __declspec(dllimport)
+	#endif
+#else
+	#define GF_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GF_AGENTS 2
+
+/**  returned by reset and step */
+#define GF_OK 0
+#define GF_INVALID_ARGUMENT 1 // a NULL handle or array, nothing was changed
+#define GF_FAILED 2 // the game failed part way, reset before stepping again
+
+typedef struct gf_env gf_env;
+
+/**  count environments sharing threads worker threads, 0 steps them all on the calling thread.
+ * NULL if count is not positive or the environments could not be made */
+GF_API gf_env* gf_env_create(int count, int threads);
+GF_API void gf_env_destroy(gf_env* env);
+
+GF_API int gf_env_count(const gf_env* env); // 0 for NULL
+GF_API int gf_observation_size(void);
+
+/**  environment e starts over with seed + e */
+GF_API int gf_env_reset(gf_env* env, uint32_t seed, float* observations);
+GF_API int gf_env_step(gf_env* env, const uint8_t* actions, float* observations, float* rewards, uint8_t* dones);
+
+/**  why the last call on this thread failed, empty if none has. Valid until the next failure */
+GF_API const char* gf_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
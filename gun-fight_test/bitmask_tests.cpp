@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../gun-fight/bitmask.h"
+
+#include <cstdint>
+#include <initializer_list>
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace {
+	/**  a one row mask with the given columns opaque */
+	collision::bitmask row_of(int width, std::initializer_list<int> opaque) {
+		auto mask = collision::bitmask(width, 1);
+		for (auto x : opaque) {
+			mask.set(x, 0);
+		}
+		return mask;
+	}
+
+	std::uint64_t bit(int n) {
+		return std::uint64_t{ 1 } << n;
+	}
+}
+
+namespace gunfighttest {
+	TEST_CLASS(bitmasktests) {
+	public:
+		TEST_METHOD(BitsInOneWord) {
+			auto mask = row_of(40, { 0, 5, 39 });
+			Assert::IsTrue(mask.get_bits(0, 0) == (bit(0) | bit(5) | bit(39)));
+			Assert::IsTrue(mask.get_bits(5, 0) == (bit(0) | bit(34)));
+		}
+		TEST_METHOD(BitsLeftOfMask) {
+			// the run starts in the word before the first, which is empty
+			auto mask = row_of(10, { 0, 3 });
+			Assert::IsTrue(mask.get_bits(-2, 0) == (bit(2) | bit(5)));
+			Assert::IsTrue(mask.get_bits(-63, 0) == bit(63));
+			Assert::IsTrue(mask.get_bits(-64, 0) == 0);
+		}
+		TEST_METHOD(BitsStraddleWords) {
+			auto mask = row_of(100, { 60, 63, 64, 70 });
+			Assert::IsTrue(mask.get_bits(58, 0) == (bit(2) | bit(5) | bit(6) | bit(12)));
+			Assert::IsTrue(mask.get_bits(64, 0) == (bit(0) | bit(6)));
+		}
+		TEST_METHOD(BitsOffMask) {
+			auto mask = row_of(100, { 99 });
+			Assert::IsTrue(mask.get_bits(90, 0) == bit(9));
+			Assert::IsTrue(mask.get_bits(100, 0) == 0);
+			Assert::IsTrue(mask.get_bits(0, 1) == 0);
+			Assert::IsTrue(mask.get_bits(0, -1) == 0);
+		}
+		TEST_METHOD(OverlapOffset) {
+			auto a = row_of(8, { 7 });
+			auto b = row_of(8, { 2 });
+			auto source = Rectangle{ 0, 0, 8, 1 };
+			Assert::IsTrue(collision::pixels_overlap(a, source, Vector2{ 0, 0 }, b, source, Vector2{ 5, 0 }));
+			Assert::IsFalse(collision::pixels_overlap(a, source, Vector2{ 0, 0 }, b, source, Vector2{ 4, 0 }));
+			Assert::IsFalse(collision::pixels_overlap(a, source, Vector2{ 0, 0 }, b, source, Vector2{ 5, 1 }));
+		}
+		TEST_METHOD(OverlapSharedWidth64) {
+			// the whole word is in range, the last column included
+			auto a = row_of(64, { 63 });
+			auto b = row_of(64, { 63 });
+			auto c = row_of(64, { 62 });
+			auto source = Rectangle{ 0, 0, 64, 1 };
+			Assert::IsTrue(collision::pixels_overlap(a, source, Vector2{ 0, 0 }, b, source, Vector2{ 0, 0 }));
+			Assert::IsFalse(collision::pixels_overlap(a, source, Vector2{ 0, 0 }, c, source, Vector2{ 0, 0 }));
+		}
+		TEST_METHOD(OverlapOutsideFrame) {
+			// pixels of the next frame on the sheet are read with the word but are out of range
+			auto a = row_of(128, { 63 });
+			auto b = row_of(128, { 63 });
+			auto frame = Rectangle{ 0, 0, 63, 1 };
+			Assert::IsFalse(collision::pixels_overlap(a, frame, Vector2{ 0, 0 }, b, frame, Vector2{ 0, 0 }));
+			Assert::IsTrue(collision::pixels_overlap(a, Rectangle{ 0, 0, 64, 1 }, Vector2{ 0, 0 }, b, Rectangle{ 0, 0, 64, 1 }, Vector2{ 0, 0 }));
+		}
+	};
+}
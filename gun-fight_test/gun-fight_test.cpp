@@ -1,59 +1,94 @@
 #include "pch.h"
 #include "CppUnitTest.h"
-#include "../gun-fight/weapons.h"
+#include "../gun-fight/entities.h"
+#include "../gun-fight/resources.h"
 
 #include <memory>
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
+namespace {
+	std::unique_ptr<entities::revolver> make_revolver() {
+		resources::set_headless(true);
+		return std::make_unique<entities::revolver>(0.0f, 0.0f, config::REVOLVER_PATH);
+	}
+
+	/**  wait out the cooldown so the next shot is allowed */
+	void cool_down(entities::weapon& weapon) {
+		while (weapon.get_cooldown() > 0) {
+			weapon.decrement_cooldown();
+		}
+	}
+}
+
 namespace gunfighttest{
 	TEST_CLASS(revolvertests){
 	public:
 		TEST_METHOD(WepInit){
-			auto rev = std::make_unique<wep::revolver>(wep::revolver());
-			Assert::AreEqual(rev->get_ammo(), wep::REVOLVER_AMMO);
-			Assert::AreEqual(rev->get_damage(), wep::REVOLVER_DMG);
+			auto rev = make_revolver();
+			Assert::AreEqual(rev->get_ammo(), config::REVOLVER_AMMO);
+			Assert::AreEqual(rev->get_fire_rate(), config::REVOLVER_FIRE_RATE);
+			Assert::AreEqual(rev->get_cooldown(), 0);
 			Assert::AreEqual(rev->is_loaded(), true);
 		}
 		TEST_METHOD(WepFireReloadLoaded) {
-			auto rev = std::make_unique<wep::revolver>(wep::revolver());
+			auto rev = make_revolver();
 
-			// fire the weapon then reload
+			// fire the weapon then reload, the round is taken from the spare ammo
 			Assert::AreEqual(rev->fire(), true);
 			Assert::AreEqual(rev->is_loaded(), false);
+			cool_down(*rev);
 			Assert::AreEqual(rev->fire(), false);
 			Assert::AreEqual(rev->reload(), true);
-			Assert::AreEqual(rev->get_ammo(), 5);
+			Assert::AreEqual(rev->get_ammo(), config::REVOLVER_AMMO - 1);
 			Assert::AreEqual(rev->is_loaded(), true);
 		}
 		TEST_METHOD(WepReloadLoaded) {
-			auto rev = std::make_unique<wep::revolver>(wep::revolver());
+			auto rev = make_revolver();
 
 			Assert::AreEqual(rev->is_loaded(), true);
 			Assert::AreEqual(rev->reload(), true);
-			Assert::AreEqual(rev->get_ammo(), 5);
+			Assert::AreEqual(rev->get_ammo(), config::REVOLVER_AMMO);
 			Assert::AreEqual(rev->is_loaded(), true);
 		}
 		TEST_METHOD(WepFireUnloaded) {
-			auto rev = std::make_unique<wep::revolver>(wep::revolver());
+			auto rev = make_revolver();
 			Assert::AreEqual(rev->is_loaded(), true);
 			Assert::AreEqual(rev->fire(), true);
+			cool_down(*rev);
+			Assert::AreEqual(rev->fire(), false);
+		}
+		TEST_METHOD(WepFireCooldown) {
+			auto rev = make_revolver();
+			Assert::AreEqual(rev->fire(), true);
+			Assert::AreEqual(rev->reload(), true);
+			// loaded again, but the shot waits for the cooldown
 			Assert::AreEqual(rev->fire(), false);
+			cool_down(*rev);
+			Assert::AreEqual(rev->fire(), true);
 		}
 		TEST_METHOD(WepNoAmmo) {
-			auto rev = std::make_unique<wep::revolver>(wep::revolver());
+			auto rev = make_revolver();
 			Assert::AreEqual(rev->is_loaded(), true);
 			while (rev->get_ammo() > 0) {
 				rev->fire();
+				cool_down(*rev);
 				rev->reload();
 			}
 			Assert::AreEqual(rev->get_ammo(), 0);
 			Assert::AreEqual(rev->is_loaded(), true);
-			// cannot reload, no spare bullets
-			Assert::AreEqual(rev->reload(), false);
 
-			// fire the last bullet and try to reload
+			// fire the last bullet and try to reload, there are no spare bullets
 			Assert::AreEqual(rev->fire(), true);
 			Assert::AreEqual(rev->reload(), false);
+			Assert::AreEqual(rev->is_empty(), true);
+		}
+		TEST_METHOD(WepReplenish) {
+			auto rev = make_revolver();
+			rev->fire();
+			rev->replenish();
+			Assert::AreEqual(rev->get_ammo(), config::REVOLVER_AMMO);
+			Assert::AreEqual(rev->get_cooldown(), 0);
+			Assert::AreEqual(rev->is_loaded(), true);
 		}
 	};
 	TEST_CLASS(gunmantests) {
@@ -0,0 +1,43 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../gun-fight/gym.h"
+#include "../gun-fight/resources.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace {
+	/**  where player 1's pickups start in its observation */
+	const std::size_t PICKUP_OFFSET = gym::AGENTS * gym::GUNMAN_FEATURES + config::GYM_MAX_PROJECTILES * gym::PROJECTILE_FEATURES;
+
+	bool sees_pickup(const std::vector<float>& observations) {
+		auto first = observations.begin() + PICKUP_OFFSET;
+		return std::any_of(first, first + config::GYM_MAX_PICKUPS * gym::PICKUP_FEATURES, [](float v) { return v != 0.0f; });
+	}
+}
+
+namespace gunfighttest {
+	TEST_CLASS(gymtests) {
+	public:
+		TEST_METHOD(PickupsSpawnAfterTimeout) {
+			resources::set_headless(true);
+			auto env = gym::environment();
+			auto observations = std::vector<float>(gym::AGENTS * gym::OBSERVATION_SIZE);
+			auto rewards = std::array<float, gym::AGENTS>{};
+			auto idle = std::array<gym::action, gym::AGENTS>{};
+			env.reset(7, observations.data());
+
+			// neither gunman fires, so the round only ends by running out of time
+			auto ticks = 0;
+			while (not env.step(idle.data(), observations.data(), rewards.data())) {
+				++ticks;
+			}
+			Assert::AreEqual(config::GYM_MAX_TICKS - 1, ticks);
+
+			env.step(idle.data(), observations.data(), rewards.data());
+			Assert::IsTrue(sees_pickup(observations), L"no pickups spawned in the round after a timeout");
+		}
+	};
+}
@@ -0,0 +1,116 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../gun-fight/game_manager.h"
+#include "../gun-fight/jobs.h"
+#include "../gun-fight/resources.h"
+#include "../gun-fight/utility.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace {
+	/**  more than config::UPDATE_GRAIN, so a bound pool shares the update out */
+	const int SCENE_SIZE = 1400;
+	const int TICKS = 120;
+	/**  one of each projectile and a barrel every this many entities. The scene is dense, more would
+	 * publish over config::EVENT_QUEUE_SIZE events in a tick and which were dropped would differ */
+	const int PROJECTILE_SPACING = 700;
+
+	/**  archetype, position, health and removal of one entity */
+	using entity_state = std::tuple<std::uintptr_t, float, float, int, bool>;
+	/**  kind, player, target and position of one event */
+	using event_state = std::tuple<int, int, std::uintptr_t, float, float>;
+
+	struct outcome {
+		std::vector<entity_state> entities;
+		std::vector<event_state> events;
+	};
+
+	/**  every kind of entity that updates against the others, placed the same way each time */
+	std::vector<std::shared_ptr<entities::entity>> make_scene(bool shuffled) {
+		auto gen = std::mt19937(99);
+		auto random = util::generator_scope(gen);
+		auto x = std::uniform_real_distribution<float>(config::PLAYABLE_X, config::PLAYABLE_WIDTH - 200);
+		auto y = std::uniform_real_distribution<float>(config::PLAYABLE_Y, config::PLAYABLE_HEIGHT - 200);
+		auto scene = std::vector<std::shared_ptr<entities::entity>>{};
+		for (auto i = 0; i < SCENE_SIZE; ++i) {
+			auto px = x(gen);
+			auto py = y(gen);
+			auto direction = i % 2 == 0 ? 1.0f : -1.0f;
+			switch (i % PROJECTILE_SPACING) {
+			case 5: scene.push_back(std::make_shared<entities::bullet>(px, py, config::BULLET_LEFT, direction)); break;
+			case 6: scene.push_back(std::make_shared<entities::dynamite_stick>(px, py, config::BULLET_LEFT, 1.0f, static_cast<float>(i % 300))); break;
+			case 7: scene.push_back(std::make_shared<entities::barrel>(px, py)); break;
+			default:
+				switch (i % 3) {
+				case 0: scene.push_back(std::make_shared<entities::wagon>(px, py, 0.0f, direction * archetype::WAGON.speed)); break;
+				case 1: scene.push_back(std::make_shared<entities::tumbleweed>(px, py)); break;
+				default: scene.push_back(std::make_shared<entities::cactus>(px, py)); break;
+				}
+			}
+		}
+		if (shuffled) {
+			std::shuffle(scene.begin(), scene.end(), std::mt19937(5));
+		}
+		return scene;
+	}
+
+	/**  the scene run for TICKS ticks, inline unless a pool is given */
+	outcome run(bool shuffled, jobs::pool* pool) {
+		resources::set_headless(true);
+		auto manager = game_manager(player::create(1), player::create(2));
+		auto scene = make_scene(shuffled);
+		for (auto& e : scene) {
+			manager.add_entity(e);
+		}
+		auto result = outcome{};
+		auto shared = pool != nullptr ? std::make_unique<jobs::pool_scope>(*pool) : nullptr;
+		for (auto tick = 0; tick < TICKS; ++tick) {
+			manager.update_entities();
+			manager.remove_entities();
+			manager.get_audio_events().drain([&result](const events::event& e) {
+				result.events.push_back({ static_cast<int>(e.type), e.player, reinterpret_cast<std::uintptr_t>(e.target), e.position.x, e.position.y });
+				});
+		}
+		Assert::IsTrue(manager.get_audio_events().get_dropped() == 0, L"events were dropped, the runs cannot be compared");
+		for (auto& e : scene) {
+			auto health = 0;
+			if (auto obstacle = dynamic_cast<entities::obstacle*>(e.get())) { health = obstacle->get_health(); }
+			result.entities.push_back({ reinterpret_cast<std::uintptr_t>(e->get_archetype()), e->get_x(), e->get_y(), health, e->get_remove() });
+		}
+		return result;
+	}
+
+	void sort(outcome& o) {
+		std::sort(o.entities.begin(), o.entities.end());
+		std::sort(o.events.begin(), o.events.end());
+	}
+}
+
+namespace gunfighttest {
+	TEST_CLASS(updatetests) {
+	public:
+		TEST_METHOD(PoolMatchesInline) {
+			auto pool = jobs::pool(3);
+			auto inline_run = run(false, nullptr);
+			auto pooled = run(false, &pool);
+			Assert::IsFalse(inline_run.events.empty());
+			Assert::IsTrue(inline_run.entities == pooled.entities, L"entity states differ");
+			Assert::IsTrue(inline_run.events == pooled.events, L"events differ");
+		}
+		TEST_METHOD(ListOrderDoesNotMatter) {
+			// each entity reads the state the tick started with, so only the order of the results changes
+			auto in_order = run(false, nullptr);
+			auto shuffled = run(true, nullptr);
+			sort(in_order);
+			sort(shuffled);
+			Assert::IsTrue(in_order.entities == shuffled.entities, L"entity states differ");
+			Assert::IsTrue(in_order.events == shuffled.events, L"events differ");
+		}
+	};
+}